@@ -0,0 +1,137 @@
+#pragma once
+
+#include <xitren/math/matrix.hpp>
+#include <xitren/math/matrix_strassen.hpp>
+#include <xitren/math/tuning.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace xitren::math {
+
+/**
+ * Benchmarks the kernel parameters on the running host:
+ * the classical micro-kernel rows, the Strassen cutoff and the batch value of matrix for Size x Size products.
+ * The winners become the current parameters. Run-time ones take effect at once; the batch value is a compile-time
+ * one and is applied by building with XITREN_MATH_BATCH set to it.
+ */
+template <class Type, std::size_t Size = 256>
+class autotune {
+    static_assert((Size & (Size - 1)) == 0, "Should be power of 2!");
+
+    using strassen_type = matrix_strassen<Type, Size>;
+
+public:
+    autotune() = delete;
+
+    /**
+     * Runs the benchmarks
+     * @param repeats the runs per candidate, the fastest one counts
+     * @return the best parameters
+     */
+    static tuning_parameters
+    run(std::size_t repeats = 3)
+    {
+        auto       params = tuning::current();
+        auto const a      = std::make_unique<strassen_type>(strassen_type::get_rand_matrix(1));
+        auto const b      = std::make_unique<strassen_type>(strassen_type::get_rand_matrix(2));
+        auto const c      = std::make_unique<strassen_type>();
+        auto const strassen_time = [&] { return measure(repeats, [&] { a->mult(*b, *c); }); };
+
+        // Micro-kernel shape with the classical kernel only
+        params.strassen_cutoff = Size;
+        params.kernel_rows     = pick(std::array<std::size_t, 4>{{1, 2, 4, 8}}, [&](std::size_t rows) {
+            params.kernel_rows = rows;
+            tuning::set(params);
+            return strassen_time();
+        });
+        // Strassen depth
+        std::vector<std::size_t> cutoffs;
+        for (std::size_t cutoff{2}; cutoff <= Size; cutoff <<= 1) {
+            cutoffs.push_back(cutoff);
+        }
+        params.strassen_cutoff = pick(cutoffs, [&](std::size_t cutoff) {
+            params.strassen_cutoff = cutoff;
+            tuning::set(params);
+            return strassen_time();
+        });
+        tuning::set(params);
+        // Batch value of the hybrid matrix
+        double best{std::numeric_limits<double>::max()};
+        [&]<std::size_t... Batches>(std::index_sequence<Batches...>) {
+            (time_batch<Batches>(repeats, params, best), ...);
+        }(std::index_sequence<16, 32, 64, 128>{});
+        tuning::set(params);
+        return params;
+    }
+
+    /**
+     * Runs the benchmarks and stores the winners for the next start, which applies them with tuning::load()
+     * @param path the tuning file
+     * @param repeats the runs per candidate
+     * @return the best parameters
+     */
+    static tuning_parameters
+    run_and_save(std::filesystem::path const& path = tuning::default_path(), std::size_t repeats = 3)
+    {
+        auto const params = run(repeats);
+        tuning::save(path, params);
+        return params;
+    }
+
+private:
+    template <class Func>
+    static double
+    measure(std::size_t repeats, Func func)
+    {
+        double best{std::numeric_limits<double>::max()};
+        for (std::size_t i{}; i < std::max<std::size_t>(repeats, 1); i++) {
+            auto const start = std::chrono::steady_clock::now();
+            func();
+            std::chrono::duration<double> const spent = std::chrono::steady_clock::now() - start;
+            best                                      = std::min(best, spent.count());
+        }
+        return best;
+    }
+
+    template <class Candidates, class Func>
+    static std::size_t
+    pick(Candidates const& candidates, Func time)
+    {
+        double      best{std::numeric_limits<double>::max()};
+        std::size_t winner{};
+        for (auto candidate : candidates) {
+            auto const spent = time(candidate);
+            if (spent < best) {
+                best   = spent;
+                winner = candidate;
+            }
+        }
+        return winner;
+    }
+
+    template <std::size_t Batch>
+    static void
+    time_batch(std::size_t repeats, tuning_parameters& params, double& best)
+    {
+        if constexpr (Batch <= Size) {
+            using matrix_type = matrix<Type, Size, Size, Batch>;
+            auto const a      = std::make_unique<matrix_type>(matrix_type::get_rand_matrix(1));
+            auto const b      = std::make_unique<matrix_type>(matrix_type::get_rand_matrix(2));
+            auto const c      = std::make_unique<matrix_type>();
+            auto const spent  = measure(repeats, [&] { a->mult(*b, *c); });
+            if (spent < best) {
+                best         = spent;
+                params.batch = Batch;
+            }
+        }
+    }
+};
+
+}    // namespace xitren::math
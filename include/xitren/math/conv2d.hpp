@@ -0,0 +1,260 @@
+#pragma once
+
+#include <xitren/math/matrix.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace xitren::math {
+
+/**
+ * Multi-channel 2D convolution (valid region, stride 1) lowered to the tiled GEMM.
+ * Images are planar: element (channel, y, x) of the input is in[(channel * Height + y) * Width + x], the output
+ * holds Filters planes of out_height x out_width. Type is the arithmetic type, e.g. std::int32_t for exact
+ * results on std::uint8_t images.
+ * Both paths work on bands of Band output rows, so the lowered matrices stay bounded on large images.
+ */
+template <class Type, std::size_t Height, std::size_t Width, std::size_t Channels, std::size_t Filters,
+          std::size_t Kernel = 3, std::size_t Batch = 16>
+class conv2d {
+    static_assert(Kernel >= 1 && Kernel <= Height && Kernel <= Width, "Kernel should fit the image!");
+
+    static constexpr std::size_t patch = Channels * Kernel * Kernel;
+
+    // Matrix types need both dimensions above one, unused padding stays zero
+    static constexpr std::size_t
+    dim(std::size_t size)
+    {
+        return std::max<std::size_t>(size, 2);
+    }
+
+public:
+    static constexpr std::size_t out_height = Height - Kernel + 1;
+    static constexpr std::size_t out_width  = Width - Kernel + 1;
+
+    using weights_type = std::array<Type, Filters * patch>;    // [filter][channel][ky][kx]
+    using output_type  = std::array<Type, Filters * out_height * out_width>;
+
+    /**
+     * Prepares the lowered weights of both paths
+     * @param weights the kernels, [filter][channel][ky][kx]
+     */
+    explicit conv2d(weights_type const& weights) : weights_{std::make_unique<weights_matrix_type>()}
+    {
+        weights_->for_each([&weights](std::size_t row, std::size_t column, Type& item) {
+            item = ((row < patch) && (column < Filters)) ? weights[column * patch + row] : Type{};
+        });
+        if constexpr (Kernel == 3) {
+            prepare_winograd(weights);
+        }
+    }
+
+    /**
+     * Convolution through im2col: every band becomes a (pixels x patch) matrix multiplied by the
+     * (patch x Filters) weights, pixels are the GEMM rows so the bands of tiles spread over the threads
+     * @param in the planar input image
+     * @param out the planar output
+     */
+    template <std::size_t Band = out_height, class Input>
+    void
+    im2col(std::array<Input, Channels * Height * Width> const& in, output_type& out) const
+    {
+        static_assert(Band >= 1 && Band <= out_height);
+        constexpr auto pixels = Band * out_width;
+        using patches_type    = matrix<Type, dim(pixels), dim(patch), Batch>;
+        using result_type     = matrix<Type, dim(pixels), dim(Filters), Batch>;
+
+        auto patches = std::make_unique<patches_type>();
+        auto result  = std::make_unique<result_type>();
+        for (std::size_t first{}; first < out_height; first += Band) {
+            auto const rows = std::min(Band, out_height - first);
+            patches->for_each([&](std::size_t pixel, std::size_t index, Type& item) {
+                if ((pixel >= rows * out_width) || (index >= patch)) {
+                    item = Type{};
+                    return;
+                }
+                auto const channel = index / (Kernel * Kernel);
+                auto const ky      = (index / Kernel) % Kernel;
+                auto const kx      = index % Kernel;
+                auto const y       = first + pixel / out_width + ky;
+                auto const x       = pixel % out_width + kx;
+                item               = static_cast<Type>(in[(channel * Height + y) * Width + x]);
+            });
+            patches->mult(*weights_, *result);
+            result->for_each([&](std::size_t pixel, std::size_t filter, Type const& item) {
+                if ((pixel < rows * out_width) && (filter < Filters)) {
+                    out[(filter * out_height + first) * out_width + pixel] = item;
+                }
+            });
+        }
+    }
+
+    /**
+     * Winograd F(2x2, 3x3): every 2x2 output tile costs 16 multiplies per channel and filter instead of 36.
+     * The 16 elements of the transformed tiles are 16 independent (tiles x Channels) by (Channels x Filters)
+     * GEMMs. Kernels are transformed with 2 * G, so integral types stay exact, the result is divided by 4.
+     * @param in the planar input image
+     * @param out the planar output
+     */
+    template <std::size_t Band = out_height + out_height % 2, class Input>
+    void
+    winograd(std::array<Input, Channels * Height * Width> const& in, output_type& out) const
+    {
+        static_assert(Kernel == 3, "Winograd F(2x2, 3x3) needs a 3x3 kernel!");
+        static_assert(Band >= 2 && Band % 2 == 0, "Band should be a positive even number of rows!");
+        constexpr auto tile_columns = (out_width + 1) / 2;
+        constexpr auto tiles        = Band / 2 * tile_columns;
+        using input_type            = matrix<Type, dim(tiles), dim(Channels), Batch>;
+        using result_type           = matrix<Type, dim(tiles), dim(Filters), Batch>;
+
+        std::vector<std::unique_ptr<input_type>>  inputs(16);
+        std::vector<std::unique_ptr<result_type>> results(16);
+        for (std::size_t k{}; k < 16; k++) {
+            inputs[k]  = std::make_unique<input_type>();
+            results[k] = std::make_unique<result_type>();
+        }
+        std::vector<Type> transformed(16 * tiles * Channels);
+        std::vector<Type> products(16 * tiles * Filters);
+        for (std::size_t first{}; first < out_height; first += Band) {
+            auto const tile_rows = (std::min(Band, out_height - first) + 1) / 2;
+            // V = B^T * d * B for every 4x4 input tile, zeros beyond the image
+            std::fill(transformed.begin(), transformed.end(), Type{});
+            for (std::size_t tile{}; tile < tile_rows * tile_columns; tile++) {
+                auto const y0 = first + (tile / tile_columns) * 2;
+                auto const x0 = (tile % tile_columns) * 2;
+                for (std::size_t channel{}; channel < Channels; channel++) {
+                    std::array<Type, 16> d{};
+                    for (std::size_t i{}; i < 4; i++) {
+                        for (std::size_t j{}; j < 4; j++) {
+                            if ((y0 + i < Height) && (x0 + j < Width)) {
+                                d[i * 4 + j] = static_cast<Type>(in[(channel * Height + y0 + i) * Width + x0 + j]);
+                            }
+                        }
+                    }
+                    auto const v = input_transform(d);
+                    for (std::size_t k{}; k < 16; k++) {
+                        transformed[(k * tiles + tile) * Channels + channel] = v[k];
+                    }
+                }
+            }
+            for (std::size_t k{}; k < 16; k++) {
+                Type const* plane = &transformed[k * tiles * Channels];
+                inputs[k]->for_each([plane](std::size_t tile, std::size_t channel, Type& item) {
+                    item = ((tile < tiles) && (channel < Channels)) ? plane[tile * Channels + channel] : Type{};
+                });
+                inputs[k]->mult(*winograd_weights_[k], *results[k]);
+                Type* product = &products[k * tiles * Filters];
+                results[k]->for_each([product](std::size_t tile, std::size_t filter, Type const& item) {
+                    if ((tile < tiles) && (filter < Filters)) {
+                        product[tile * Filters + filter] = item;
+                    }
+                });
+            }
+            // Y = A^T * M * A / 4 for every tile and filter
+            for (std::size_t tile{}; tile < tile_rows * tile_columns; tile++) {
+                auto const y0 = first + (tile / tile_columns) * 2;
+                auto const x0 = (tile % tile_columns) * 2;
+                for (std::size_t filter{}; filter < Filters; filter++) {
+                    std::array<Type, 16> m;
+                    for (std::size_t k{}; k < 16; k++) {
+                        m[k] = products[(k * tiles + tile) * Filters + filter];
+                    }
+                    auto const y = output_transform(m);
+                    for (std::size_t i{}; i < 2; i++) {
+                        for (std::size_t j{}; j < 2; j++) {
+                            if ((y0 + i < out_height) && (x0 + j < out_width)) {
+                                out[(filter * out_height + y0 + i) * out_width + x0 + j] = y[i * 2 + j] / Type{4};
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    using weights_matrix_type  = matrix<Type, dim(patch), dim(Filters), Batch>;
+    using winograd_weight_type = matrix<Type, dim(Channels), dim(Filters), Batch>;
+
+    std::unique_ptr<weights_matrix_type>               weights_;
+    std::vector<std::unique_ptr<winograd_weight_type>> winograd_weights_;
+
+    // U = (2G) * g * (2G)^T for every kernel, element k of U goes to the (Channels x Filters) matrix k
+    void
+    prepare_winograd(weights_type const& weights)
+    {
+        static constexpr std::array<std::array<Type, 3>, 4> g2{{{Type{2}, Type{0}, Type{0}},
+                                                                {Type{1}, Type{1}, Type{1}},
+                                                                {Type{1}, Type{-1}, Type{1}},
+                                                                {Type{0}, Type{0}, Type{2}}}};
+        std::vector<Type> planes(16 * Channels * Filters);
+        for (std::size_t filter{}; filter < Filters; filter++) {
+            for (std::size_t channel{}; channel < Channels; channel++) {
+                Type const*          g = &weights[(filter * Channels + channel) * 9];
+                std::array<Type, 12> gg{};    // (2G) * g, 4x3
+                for (std::size_t i{}; i < 4; i++) {
+                    for (std::size_t j{}; j < 3; j++) {
+                        for (std::size_t k{}; k < 3; k++) {
+                            gg[i * 3 + j] += g2[i][k] * g[k * 3 + j];
+                        }
+                    }
+                }
+                for (std::size_t i{}; i < 4; i++) {
+                    for (std::size_t j{}; j < 4; j++) {
+                        Type sum{};
+                        for (std::size_t k{}; k < 3; k++) {
+                            sum += gg[i * 3 + k] * g2[j][k];
+                        }
+                        planes[((i * 4 + j) * Channels + channel) * Filters + filter] = sum;
+                    }
+                }
+            }
+        }
+        for (std::size_t k{}; k < 16; k++) {
+            auto        weight = std::make_unique<winograd_weight_type>();
+            Type const* plane  = &planes[k * Channels * Filters];
+            weight->for_each([plane](std::size_t channel, std::size_t filter, Type& item) {
+                item = ((channel < Channels) && (filter < Filters)) ? plane[channel * Filters + filter] : Type{};
+            });
+            winograd_weights_.push_back(std::move(weight));
+        }
+    }
+
+    // B^T * d * B with B^T = [1 0 -1 0; 0 1 1 0; 0 -1 1 0; 0 1 0 -1]
+    static std::array<Type, 16>
+    input_transform(std::array<Type, 16> const& d)
+    {
+        std::array<Type, 16> t;
+        for (std::size_t j{}; j < 4; j++) {
+            t[0 * 4 + j] = d[0 * 4 + j] - d[2 * 4 + j];
+            t[1 * 4 + j] = d[1 * 4 + j] + d[2 * 4 + j];
+            t[2 * 4 + j] = d[2 * 4 + j] - d[1 * 4 + j];
+            t[3 * 4 + j] = d[1 * 4 + j] - d[3 * 4 + j];
+        }
+        std::array<Type, 16> v;
+        for (std::size_t i{}; i < 4; i++) {
+            v[i * 4 + 0] = t[i * 4 + 0] - t[i * 4 + 2];
+            v[i * 4 + 1] = t[i * 4 + 1] + t[i * 4 + 2];
+            v[i * 4 + 2] = t[i * 4 + 2] - t[i * 4 + 1];
+            v[i * 4 + 3] = t[i * 4 + 1] - t[i * 4 + 3];
+        }
+        return v;
+    }
+
+    // A^T * m * A with A^T = [1 1 1 0; 0 1 -1 -1]
+    static std::array<Type, 4>
+    output_transform(std::array<Type, 16> const& m)
+    {
+        std::array<Type, 8> t;
+        for (std::size_t j{}; j < 4; j++) {
+            t[0 * 4 + j] = m[0 * 4 + j] + m[1 * 4 + j] + m[2 * 4 + j];
+            t[1 * 4 + j] = m[1 * 4 + j] - m[2 * 4 + j] - m[3 * 4 + j];
+        }
+        return {t[0] + t[1] + t[2], t[1] - t[2] - t[3], t[4] + t[5] + t[6], t[5] - t[6] - t[7]};
+    }
+};
+
+}    // namespace xitren::math
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+
+namespace xitren::math {
+
+/**
+ * Fixed size delay line of the last Size samples.
+ * Every sample is written twice, at position i and i + Size of a double length buffer, so the samples from the
+ * oldest to the newest are always a contiguous run: begin() and end() are plain pointers and a dot product over
+ * the window needs no wrap around. It keeps the push / full / begin / end / clear / operator<< interface of a
+ * circular buffer.
+ */
+template <class Type, std::size_t Size>
+class delay_line {
+    static_assert(Size >= 1, "Delay line should hold at least one sample!");
+
+public:
+    using value_type     = Type;
+    using const_iterator = Type const*;
+
+    /**
+     * Appends a sample, the oldest one is dropped when the line is full
+     * @param value the new sample
+     */
+    constexpr void
+    push(Type const& value)
+    {
+        data_[head_]        = value;
+        data_[head_ + Size] = value;
+        if (++head_ == Size) {
+            head_ = 0;
+        }
+        if (count_ < Size) {
+            count_++;
+        }
+    }
+
+    /**
+     * Appends all samples of an array, oldest first
+     * @param data the samples
+     * @return the delay line
+     */
+    template <std::size_t N>
+    constexpr delay_line&
+    operator<<(std::array<Type, N> const& data)
+    {
+        for (auto const& item : data) {
+            push(item);
+        }
+        return *this;
+    }
+
+    /**
+     * Appends a sample
+     * @param value the new sample
+     * @return the delay line
+     */
+    constexpr delay_line&
+    operator<<(Type const& value)
+    {
+        push(value);
+        return *this;
+    }
+
+    [[nodiscard]] constexpr bool
+    full() const
+    {
+        return count_ == Size;
+    }
+
+    [[nodiscard]] constexpr bool
+    empty() const
+    {
+        return count_ == 0;
+    }
+
+    [[nodiscard]] constexpr std::size_t
+    size() const
+    {
+        return count_;
+    }
+
+    static constexpr std::size_t
+    capacity()
+    {
+        return Size;
+    }
+
+    /**
+     * Drops all samples
+     */
+    constexpr void
+    clear()
+    {
+        head_  = 0;
+        count_ = 0;
+    }
+
+    /**
+     * Returns the oldest sample
+     * @return pointer to the oldest sample, the others follow it up to end()
+     */
+    [[nodiscard]] constexpr const_iterator
+    begin() const
+    {
+        return data_.data() + head_ + Size - count_;
+    }
+
+    /**
+     * Returns the position after the newest sample
+     * @return pointer after the newest sample
+     */
+    [[nodiscard]] constexpr const_iterator
+    end() const
+    {
+        return data_.data() + head_ + Size;
+    }
+
+    /**
+     * Returns the samples from the oldest to the newest as one contiguous run
+     * @return the window of size() samples
+     */
+    [[nodiscard]] constexpr std::span<Type const>
+    window() const
+    {
+        return {begin(), count_};
+    }
+
+private:
+    std::array<Type, 2 * Size> data_{};
+    std::size_t                head_{};    // the slot the next sample goes to, in [0, Size)
+    std::size_t                count_{};
+};
+
+}    // namespace xitren::math
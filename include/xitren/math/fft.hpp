@@ -0,0 +1,570 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE3__)
+#    include <pmmintrin.h>
+#endif
+
+namespace xitren::math {
+
+namespace detail {
+
+/**
+ * Complex arithmetic of the FFT butterflies.
+ * The generic version works on std::complex without its inf/nan recovery path,
+ * the double version keeps one complex number in an SSE register.
+ */
+template <class Type>
+struct fft_ops {
+    using value_type = std::complex<Type>;
+
+    static value_type
+    load(std::complex<Type> const* ptr)
+    {
+        return *ptr;
+    }
+
+    static void
+    store(std::complex<Type>* ptr, value_type value)
+    {
+        *ptr = value;
+    }
+
+    static value_type
+    add(value_type a, value_type b)
+    {
+        return {a.real() + b.real(), a.imag() + b.imag()};
+    }
+
+    static value_type
+    sub(value_type a, value_type b)
+    {
+        return {a.real() - b.real(), a.imag() - b.imag()};
+    }
+
+    static value_type
+    mul(value_type a, value_type b)
+    {
+        return {a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real()};
+    }
+
+    static value_type
+    scale(value_type a, Type factor)
+    {
+        return {a.real() * factor, a.imag() * factor};
+    }
+
+    // a * -i
+    static value_type
+    rotate(value_type a)
+    {
+        return {a.imag(), -a.real()};
+    }
+};
+
+#if defined(__SSE3__)
+template <>
+struct fft_ops<double> {
+    using value_type = __m128d;
+
+    static value_type
+    load(std::complex<double> const* ptr)
+    {
+        return _mm_loadu_pd(reinterpret_cast<double const*>(ptr));
+    }
+
+    static void
+    store(std::complex<double>* ptr, value_type value)
+    {
+        _mm_storeu_pd(reinterpret_cast<double*>(ptr), value);
+    }
+
+    static value_type
+    add(value_type a, value_type b)
+    {
+        return _mm_add_pd(a, b);
+    }
+
+    static value_type
+    sub(value_type a, value_type b)
+    {
+        return _mm_sub_pd(a, b);
+    }
+
+    static value_type
+    mul(value_type a, value_type b)
+    {
+        auto const real    = _mm_movedup_pd(b);
+        auto const imag    = _mm_unpackhi_pd(b, b);
+        auto const swapped = _mm_shuffle_pd(a, a, 1);
+        return _mm_addsub_pd(_mm_mul_pd(a, real), _mm_mul_pd(swapped, imag));
+    }
+
+    static value_type
+    scale(value_type a, double factor)
+    {
+        return _mm_mul_pd(a, _mm_set1_pd(factor));
+    }
+
+    static value_type
+    rotate(value_type a)
+    {
+        return _mm_xor_pd(_mm_shuffle_pd(a, a, 1), _mm_set_pd(-0.0, 0.0));
+    }
+};
+#endif
+
+}    // namespace detail
+
+/**
+ * Precomputed complex FFT of any size.
+ * The size is split into radix-4, 2, 3, 5 and generic odd prime stages of a Stockham autosort transform, so no
+ * bit reversal pass is needed and every stage streams through contiguous runs. Twiddles of every stage are
+ * computed once, transforms only read the plan, so one plan can be shared by several threads.
+ * Prime factors above 5 use a generic O(p^2) butterfly, sizes with large prime factors are slow.
+ */
+template <class Type = double>
+class fft_plan {
+    using ops = detail::fft_ops<Type>;
+
+public:
+    using complex_type = std::complex<Type>;
+
+    /**
+     * Prepares the transform
+     * @param size the transform size, at least one
+     */
+    explicit fft_plan(std::size_t size) : size_{size}
+    {
+        if (size == 0) {
+            throw std::invalid_argument{"fft_plan: size should be positive"};
+        }
+        std::size_t rest{size};
+        std::size_t length{size};
+        std::size_t stride{1};
+        auto const  add_stage = [&](std::size_t radix) {
+            auto const butterflies = length / radix;
+            stages_.push_back({radix, butterflies, stride, twiddles_.size(), roots_.size()});
+            for (std::size_t j{}; j < butterflies; j++) {
+                for (std::size_t q{1}; q < radix; q++) {
+                    twiddles_.push_back(root(j * q, length));
+                }
+            }
+            if (radix > 5) {
+                for (std::size_t q{}; q < radix; q++) {
+                    for (std::size_t r{}; r < radix; r++) {
+                        roots_.push_back(root(q * r, radix));
+                    }
+                }
+            }
+            length = butterflies;
+            stride *= radix;
+            rest /= radix;
+        };
+        while (rest % 4 == 0) {
+            add_stage(4);
+        }
+        while (rest % 2 == 0) {
+            add_stage(2);
+        }
+        for (std::size_t radix{3}; rest > 1; radix += 2) {
+            while (rest % radix == 0) {
+                add_stage(radix);
+            }
+        }
+    }
+
+    /**
+     * Returns a plan shared by all users of the size, created on first use
+     * @param size the transform size
+     * @return the plan
+     */
+    static std::shared_ptr<fft_plan const>
+    cached(std::size_t size)
+    {
+        static std::mutex                                            lock;
+        static std::map<std::size_t, std::shared_ptr<fft_plan const>> plans;
+        std::lock_guard<std::mutex> const                            guard{lock};
+        auto&                                                        plan = plans[size];
+        if (!plan) {
+            plan = std::make_shared<fft_plan const>(size);
+        }
+        return plan;
+    }
+
+    [[nodiscard]] std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    /**
+     * Forward transform, X[k] = sum x[n] * exp(-2 * pi * i * k * n / size)
+     * @param data size elements, replaced by the spectrum
+     * @param scratch size elements of work space
+     */
+    void
+    forward(complex_type* data, complex_type* scratch) const
+    {
+        complex_type* in  = data;
+        complex_type* out = scratch;
+        for (auto const& item : stages_) {
+            run_stage(item, in, out);
+            std::swap(in, out);
+        }
+        if (in != data) {
+            std::copy_n(in, size_, data);
+        }
+    }
+
+    /**
+     * Forward transform with a per-thread work space
+     * @param data size elements, replaced by the spectrum
+     */
+    void
+    forward(complex_type* data) const
+    {
+        forward(data, scratch(size_));
+    }
+
+    /**
+     * Inverse transform, scaled by 1 / size so that inverse(forward(x)) == x
+     * @param data size elements of a spectrum, replaced by the signal
+     * @param scratch size elements of work space
+     */
+    void
+    inverse(complex_type* data, complex_type* scratch) const
+    {
+        // conj(F(conj(X))) / size
+        for (std::size_t i{}; i < size_; i++) {
+            data[i] = std::conj(data[i]);
+        }
+        forward(data, scratch);
+        Type const factor = Type{1} / static_cast<Type>(size_);
+        for (std::size_t i{}; i < size_; i++) {
+            data[i] = {data[i].real() * factor, -data[i].imag() * factor};
+        }
+    }
+
+    /**
+     * Inverse transform with a per-thread work space
+     * @param data size elements of a spectrum, replaced by the signal
+     */
+    void
+    inverse(complex_type* data) const
+    {
+        inverse(data, scratch(size_));
+    }
+
+private:
+    struct stage {
+        std::size_t radix;
+        std::size_t butterflies;    // length of the current sub-transforms / radix
+        std::size_t stride;         // number of interleaved sub-transforms
+        std::size_t twiddles;       // offset of the (radix - 1) twiddles of every butterfly
+        std::size_t roots;          // offset of the radix x radix DFT matrix of a generic stage
+    };
+
+    std::size_t               size_;
+    std::vector<stage>        stages_;
+    std::vector<complex_type> twiddles_;
+    std::vector<complex_type> roots_;
+
+    static complex_type
+    root(std::size_t k, std::size_t n)
+    {
+        auto const angle = -2.0L * static_cast<long double>(M_PI) * static_cast<long double>(k % n)
+                           / static_cast<long double>(n);
+        return {static_cast<Type>(std::cos(angle)), static_cast<Type>(std::sin(angle))};
+    }
+
+    static complex_type*
+    scratch(std::size_t size)
+    {
+        thread_local std::vector<complex_type> buffer;
+        if (buffer.size() < size) {
+            buffer.resize(size);
+        }
+        return buffer.data();
+    }
+
+    /**
+     * One decimation in frequency stage: the inputs of butterfly (j, k) are in[k + stride * (j + r * butterflies)],
+     * its outputs multiplied by the twiddles w^q go to out[k + stride * (radix * j + q)].
+     * The k loop runs over contiguous elements.
+     */
+    void
+    run_stage(stage const& item, complex_type const* in, complex_type* out) const
+    {
+        auto const m = item.butterflies;
+        auto const s = item.stride;
+        for (std::size_t j{}; j < m; j++) {
+            complex_type const* w   = &twiddles_[item.twiddles + j * (item.radix - 1)];
+            complex_type const* src = in + s * j;
+            complex_type*       dst = out + s * item.radix * j;
+            switch (item.radix) {
+            case 2:
+                radix2(src, dst, s, m, w);
+                break;
+            case 3:
+                radix3(src, dst, s, m, w);
+                break;
+            case 4:
+                radix4(src, dst, s, m, w);
+                break;
+            case 5:
+                radix5(src, dst, s, m, w);
+                break;
+            default:
+                radix_generic(item, src, dst, w);
+                break;
+            }
+        }
+    }
+
+    static void
+    radix2(complex_type const* src, complex_type* dst, std::size_t s, std::size_t m, complex_type const* w)
+    {
+        auto const w1 = ops::load(w);
+        for (std::size_t k{}; k < s; k++) {
+            auto const a0 = ops::load(src + k);
+            auto const a1 = ops::load(src + k + s * m);
+            ops::store(dst + k, ops::add(a0, a1));
+            ops::store(dst + k + s, ops::mul(ops::sub(a0, a1), w1));
+        }
+    }
+
+    static void
+    radix3(complex_type const* src, complex_type* dst, std::size_t s, std::size_t m, complex_type const* w)
+    {
+        constexpr Type half  = Type{0.5};
+        Type const     sin60 = static_cast<Type>(std::sqrt(3.0L) / 2);
+        auto const     w1    = ops::load(w);
+        auto const     w2    = ops::load(w + 1);
+        for (std::size_t k{}; k < s; k++) {
+            auto const a0   = ops::load(src + k);
+            auto const a1   = ops::load(src + k + s * m);
+            auto const a2   = ops::load(src + k + 2 * s * m);
+            auto const sum  = ops::add(a1, a2);
+            auto const base = ops::sub(a0, ops::scale(sum, half));
+            auto const turn = ops::scale(ops::rotate(ops::sub(a1, a2)), sin60);
+            ops::store(dst + k, ops::add(a0, sum));
+            ops::store(dst + k + s, ops::mul(ops::add(base, turn), w1));
+            ops::store(dst + k + 2 * s, ops::mul(ops::sub(base, turn), w2));
+        }
+    }
+
+    static void
+    radix4(complex_type const* src, complex_type* dst, std::size_t s, std::size_t m, complex_type const* w)
+    {
+        auto const w1 = ops::load(w);
+        auto const w2 = ops::load(w + 1);
+        auto const w3 = ops::load(w + 2);
+        for (std::size_t k{}; k < s; k++) {
+            auto const a0 = ops::load(src + k);
+            auto const a1 = ops::load(src + k + s * m);
+            auto const a2 = ops::load(src + k + 2 * s * m);
+            auto const a3 = ops::load(src + k + 3 * s * m);
+            auto const t0 = ops::add(a0, a2);
+            auto const t1 = ops::sub(a0, a2);
+            auto const t2 = ops::add(a1, a3);
+            auto const t3 = ops::rotate(ops::sub(a1, a3));
+            ops::store(dst + k, ops::add(t0, t2));
+            ops::store(dst + k + s, ops::mul(ops::add(t1, t3), w1));
+            ops::store(dst + k + 2 * s, ops::mul(ops::sub(t0, t2), w2));
+            ops::store(dst + k + 3 * s, ops::mul(ops::sub(t1, t3), w3));
+        }
+    }
+
+    static void
+    radix5(complex_type const* src, complex_type* dst, std::size_t s, std::size_t m, complex_type const* w)
+    {
+        Type const cos1 = static_cast<Type>(std::cos(2.0L * static_cast<long double>(M_PI) / 5));
+        Type const cos2 = static_cast<Type>(std::cos(4.0L * static_cast<long double>(M_PI) / 5));
+        Type const sin1 = static_cast<Type>(std::sin(2.0L * static_cast<long double>(M_PI) / 5));
+        Type const sin2 = static_cast<Type>(std::sin(4.0L * static_cast<long double>(M_PI) / 5));
+        auto const w1   = ops::load(w);
+        auto const w2   = ops::load(w + 1);
+        auto const w3   = ops::load(w + 2);
+        auto const w4   = ops::load(w + 3);
+        for (std::size_t k{}; k < s; k++) {
+            auto const a0    = ops::load(src + k);
+            auto const a1    = ops::load(src + k + s * m);
+            auto const a2    = ops::load(src + k + 2 * s * m);
+            auto const a3    = ops::load(src + k + 3 * s * m);
+            auto const a4    = ops::load(src + k + 4 * s * m);
+            auto const t1    = ops::add(a1, a4);
+            auto const t2    = ops::add(a2, a3);
+            auto const d1    = ops::sub(a1, a4);
+            auto const d2    = ops::sub(a2, a3);
+            auto const b1    = ops::add(a0, ops::add(ops::scale(t1, cos1), ops::scale(t2, cos2)));
+            auto const b2    = ops::add(a0, ops::add(ops::scale(t1, cos2), ops::scale(t2, cos1)));
+            auto const turn1 = ops::rotate(ops::add(ops::scale(d1, sin1), ops::scale(d2, sin2)));
+            auto const turn2 = ops::rotate(ops::sub(ops::scale(d1, sin2), ops::scale(d2, sin1)));
+            ops::store(dst + k, ops::add(a0, ops::add(t1, t2)));
+            ops::store(dst + k + s, ops::mul(ops::add(b1, turn1), w1));
+            ops::store(dst + k + 2 * s, ops::mul(ops::add(b2, turn2), w2));
+            ops::store(dst + k + 3 * s, ops::mul(ops::sub(b2, turn2), w3));
+            ops::store(dst + k + 4 * s, ops::mul(ops::sub(b1, turn1), w4));
+        }
+    }
+
+    void
+    radix_generic(stage const& item, complex_type const* src, complex_type* dst, complex_type const* w) const
+    {
+        auto const          p     = item.radix;
+        auto const          s     = item.stride;
+        auto const          m     = item.butterflies;
+        complex_type const* roots = &roots_[item.roots];
+        for (std::size_t k{}; k < s; k++) {
+            for (std::size_t q{}; q < p; q++) {
+                auto sum = ops::load(src + k);
+                for (std::size_t r{1}; r < p; r++) {
+                    sum = ops::add(sum, ops::mul(ops::load(src + k + r * s * m), ops::load(roots + q * p + r)));
+                }
+                ops::store(dst + k + q * s, (q == 0) ? sum : ops::mul(sum, ops::load(w + q - 1)));
+            }
+        }
+    }
+};
+
+/**
+ * Precomputed FFT of real signals of an even size, through a complex transform of half the size.
+ * The spectrum is packed as the size / 2 + 1 bins 0..size / 2, the others are their conjugates.
+ */
+template <class Type = double>
+class fft_real_plan {
+public:
+    using complex_type = std::complex<Type>;
+
+    /**
+     * Prepares the transform
+     * @param size the transform size, an even number
+     */
+    explicit fft_real_plan(std::size_t size)
+        : size_{size}, half_{(size % 2 == 0) ? fft_plan<Type>::cached(size / 2) : nullptr}, twiddles_(size / 2)
+    {
+        if ((size == 0) || (size % 2 != 0)) {
+            throw std::invalid_argument{"fft_real_plan: size should be even"};
+        }
+        for (std::size_t k{}; k < size / 2; k++) {
+            auto const angle = -2.0L * static_cast<long double>(M_PI) * static_cast<long double>(k)
+                               / static_cast<long double>(size);
+            twiddles_[k] = {static_cast<Type>(std::cos(angle)), static_cast<Type>(std::sin(angle))};
+        }
+    }
+
+    /**
+     * Returns a plan shared by all users of the size, created on first use
+     * @param size the transform size
+     * @return the plan
+     */
+    static std::shared_ptr<fft_real_plan const>
+    cached(std::size_t size)
+    {
+        static std::mutex                                                 lock;
+        static std::map<std::size_t, std::shared_ptr<fft_real_plan const>> plans;
+        std::lock_guard<std::mutex> const                                 guard{lock};
+        auto&                                                             plan = plans[size];
+        if (!plan) {
+            plan = std::make_shared<fft_real_plan const>(size);
+        }
+        return plan;
+    }
+
+    [[nodiscard]] std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    /**
+     * Forward transform of a real signal
+     * @param in size samples
+     * @param out the size / 2 + 1 bins
+     */
+    void
+    forward(Type const* in, complex_type* out) const
+    {
+        auto const h = size_ / 2;
+        // Even samples are the real parts, odd samples the imaginary parts of a half size signal
+        for (std::size_t n{}; n < h; n++) {
+            out[n] = {in[2 * n], in[2 * n + 1]};
+        }
+        half_->forward(out);
+        out[h] = out[0];
+        for (std::size_t k{}; k <= h / 2; k++) {
+            auto const z  = out[k];
+            auto const zc = std::conj(out[h - k]);
+            auto const even = (z + zc) * Type{0.5};
+            auto const odd  = complex_type{(z - zc).imag(), -(z - zc).real()} * Type{0.5};
+            auto const w    = twiddles_[k];
+            // Bin h - k has the conjugate halves and the twiddle -conj(w)
+            auto const other_even = std::conj(even);
+            auto const other_odd  = std::conj(odd);
+            out[k]                = even + w * odd;
+            out[h - k]            = other_even - std::conj(w) * other_odd;
+        }
+        out[h] = {out[h].real(), Type{}};
+        out[0] = {out[0].real(), Type{}};
+    }
+
+    /**
+     * Inverse transform to a real signal, scaled by 1 / size
+     * @param in the size / 2 + 1 bins
+     * @param out size samples
+     * @param work size / 2 + 1 elements of work space, may be in
+     */
+    void
+    inverse(complex_type const* in, Type* out, complex_type* work) const
+    {
+        auto const h = size_ / 2;
+        for (std::size_t k{}; k <= h / 2; k++) {
+            auto const x  = in[k];
+            auto const xc = std::conj(in[h - k]);
+            auto const even       = (x + xc) * Type{0.5};
+            auto const odd        = (x - xc) * Type{0.5} * std::conj(twiddles_[k]);
+            auto const other_even = std::conj(even);
+            auto const other_odd  = std::conj(odd);
+            work[k]               = even + complex_type{-odd.imag(), odd.real()};
+            work[h - k]           = other_even + complex_type{-other_odd.imag(), other_odd.real()};
+        }
+        half_->inverse(work);
+        for (std::size_t n{}; n < h; n++) {
+            out[2 * n]     = work[n].real();
+            out[2 * n + 1] = work[n].imag();
+        }
+    }
+
+    /**
+     * Inverse transform to a real signal with a per-thread work space, scaled by 1 / size
+     * @param in the size / 2 + 1 bins
+     * @param out size samples
+     */
+    void
+    inverse(complex_type const* in, Type* out) const
+    {
+        thread_local std::vector<complex_type> buffer;
+        if (buffer.size() < size_ / 2 + 1) {
+            buffer.resize(size_ / 2 + 1);
+        }
+        inverse(in, out, buffer.data());
+    }
+
+private:
+    std::size_t                           size_;
+    std::shared_ptr<fft_plan<Type> const> half_;
+    std::vector<complex_type>             twiddles_;
+};
+
+}    // namespace xitren::math
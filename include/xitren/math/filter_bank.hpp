@@ -0,0 +1,181 @@
+#pragma once
+
+#include <xitren/math/fir.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace xitren::math {
+
+/**
+ * Sample layout of a block of multi-channel frames
+ */
+enum class frame_layout {
+    interleaved,    // frame after frame, in[frame * Channels + channel]
+    planar          // channel after channel, in[channel * frames + frame]
+};
+
+/**
+ * The same FIR table applied to Channels independent channels.
+ * The histories are interleaved: slot k of the delay line holds sample k of every channel side by side, and like
+ * delay_line every frame is written twice, at slot i and i + Order, so the window of all channels is one
+ * contiguous block. Every tap is one coefficient broadcast against vectors of channels, a group of channel vectors
+ * stays in registers over all taps. Outputs match filter<Order>::value() of each channel up to rounding.
+ */
+template <std::size_t Order, std::size_t Channels>
+class filter_bank {
+    static_assert(Order >= 1 && Channels >= 1, "Filter bank should have taps and channels!");
+
+public:
+    /**
+     * Constructs a filter bank with the given table data
+     * @param table_data the table data shared by all channels
+     */
+    explicit filter_bank(std::array<double, Order> const& table_data)
+        : table_{table_data}, line_(2 * Order * Channels)
+    {}
+
+    /**
+     * Applies the filter to one frame of all channels
+     * @param frame the new data points, one per channel
+     * @param out the filtered data points, one per channel
+     */
+    void
+    value(std::span<double const, Channels> frame, std::span<double, Channels> out)
+    {
+        std::copy(frame.begin(), frame.end(), slot());
+        filter_frame(out.data());
+    }
+
+    /**
+     * Applies the filter to a block of frames
+     * @param in the new data points, a whole number of frames, planar blocks hold in.size() / Channels frames
+     * @param out the filtered data points, in the same layout
+     * @param layout the layout of in and out
+     * @return the number of processed frames, the smaller of both sizes divided by Channels
+     */
+    std::size_t
+    process(std::span<double const> in, std::span<double> out, frame_layout layout = frame_layout::interleaved)
+    {
+        auto const frames = std::min(in.size(), out.size()) / Channels;
+        if (layout == frame_layout::interleaved) {
+            for (std::size_t f{}; f < frames; f++) {
+                std::copy_n(in.begin() + f * Channels, Channels, slot());
+                filter_frame(&out[f * Channels]);
+            }
+            return frames;
+        }
+        // Planar blocks are transposed through the frame buffer
+        auto const in_stride  = in.size() / Channels;
+        auto const out_stride = out.size() / Channels;
+        for (std::size_t f{}; f < frames; f++) {
+            double* frame = slot();
+            for (std::size_t c{}; c < Channels; c++) {
+                frame[c] = in[c * in_stride + f];
+            }
+            filter_frame(frame_.data());
+            for (std::size_t c{}; c < Channels; c++) {
+                out[c * out_stride + f] = frame_[c];
+            }
+        }
+        return frames;
+    }
+
+    /**
+     * Resets the histories of all channels
+     */
+    void
+    reset()
+    {
+        std::fill(line_.begin(), line_.end(), 0.);
+        head_  = 0;
+        count_ = 0;
+    }
+
+    /**
+     * Returns the filter table data
+     * @return the filter table data
+     */
+    std::array<double, Order>
+    table() const
+    {
+        return table_;
+    }
+
+private:
+    using lane_ops = detail::lane_ops;
+
+    static constexpr std::size_t group = 32;    // channels kept in registers over all taps
+
+    std::array<double, Order>    table_;
+    std::vector<double>          line_;    // 2 * Order slots of Channels samples
+    std::array<double, Channels> frame_{};
+    std::size_t                  head_{};
+    std::size_t                  count_{};
+
+    // The slot the next frame goes to
+    double*
+    slot()
+    {
+        return &line_[head_ * Channels];
+    }
+
+    // Mirrors the frame written to slot() and filters the window that ends with it
+    void
+    filter_frame(double* out)
+    {
+        double const* frame = slot();
+        std::copy_n(frame, Channels, &line_[(head_ + Order) * Channels]);
+        if (++head_ == Order) {
+            head_ = 0;
+        }
+        if (count_ < Order) {
+            count_++;
+        }
+        if (count_ < Order) {
+            std::fill_n(out, Channels, 0.);
+            return;
+        }
+        constexpr std::size_t grouped = Channels / group * group;
+        constexpr std::size_t vectors = Channels / 4 * 4;
+
+        // The window starts at the oldest slot, the one the next frame goes to
+        double const* window = &line_[head_ * Channels];
+        for (std::size_t c{}; c < grouped; c += group) {
+            filter_group(window + c, out + c, std::make_index_sequence<group / 4>{});
+        }
+        if constexpr (vectors > grouped) {
+            filter_group(window + grouped, out + grouped, std::make_index_sequence<(vectors - grouped) / 4>{});
+        }
+        for (auto c = vectors; c < Channels; c++) {
+            double sum{};
+            for (std::size_t k{}; k < Order; k++) {
+                sum += table_[k] * window[k * Channels + c];
+            }
+            out[c] = sum;
+        }
+    }
+
+    // Consecutive vectors of four channels, one accumulator register per vector
+    template <std::size_t... Vector>
+    void
+    filter_group(double const* window, double* out, std::index_sequence<Vector...>) const
+    {
+        lane_ops::value_type sum[sizeof...(Vector)]{(void(Vector), lane_ops::zero())...};
+        for (std::size_t k{}; k < Order; k++) {
+            auto const    factor  = lane_ops::broadcast(table_[k]);
+            double const* samples = window + k * Channels;
+            auto const    update  = [&](lane_ops::value_type& item, std::size_t offset) {
+                item = lane_ops::add(item, lane_ops::mul(factor, lane_ops::load(samples + offset)));
+            };
+            (update(sum[Vector], 4 * Vector), ...);
+        }
+        (lane_ops::store(out + 4 * Vector, sum[Vector]), ...);
+    }
+};
+
+}    // namespace xitren::math
@@ -1,19 +1,186 @@
 #pragma once
 
-#include <xitren/circular_buffer.hpp>
+#include <xitren/math/delay_line.hpp>
+#include <xitren/math/fft.hpp>
 
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <cmath>
+#include <complex>
 #include <cstdint>
 #include <cstring>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX__)
+#    include <immintrin.h>
+#elif defined(__SSE2__)
+#    include <emmintrin.h>
+#endif
 
 namespace xitren::math {
 
+namespace detail {
+
+/**
+ * Four double lanes of the FIR dot products, one AVX register, two SSE2 registers or plain scalars.
+ * load_reversed(ptr) reads ptr[3], ptr[2], ptr[1], ptr[0], so the mirrored half of a window streams in the
+ * same order as the coefficients of a folded symmetric table.
+ */
+struct lane_ops {
+#if defined(__AVX__)
+    using value_type = __m256d;
+
+    static value_type
+    zero()
+    {
+        return _mm256_setzero_pd();
+    }
+
+    static value_type
+    broadcast(double value)
+    {
+        return _mm256_set1_pd(value);
+    }
+
+    static value_type
+    load(double const* ptr)
+    {
+        return _mm256_loadu_pd(ptr);
+    }
+
+    static value_type
+    load_reversed(double const* ptr)
+    {
+        auto const value = _mm256_loadu_pd(ptr);
+        return _mm256_permute_pd(_mm256_permute2f128_pd(value, value, 1), 0b0101);
+    }
+
+    static value_type
+    add(value_type a, value_type b)
+    {
+        return _mm256_add_pd(a, b);
+    }
+
+    static value_type
+    mul(value_type a, value_type b)
+    {
+        return _mm256_mul_pd(a, b);
+    }
+
+    static void
+    store(double* ptr, value_type value)
+    {
+        _mm256_storeu_pd(ptr, value);
+    }
+#elif defined(__SSE2__)
+    struct value_type {
+        __m128d low;
+        __m128d high;
+    };
+
+    static value_type
+    zero()
+    {
+        return {_mm_setzero_pd(), _mm_setzero_pd()};
+    }
+
+    static value_type
+    broadcast(double value)
+    {
+        return {_mm_set1_pd(value), _mm_set1_pd(value)};
+    }
+
+    static value_type
+    load(double const* ptr)
+    {
+        return {_mm_loadu_pd(ptr), _mm_loadu_pd(ptr + 2)};
+    }
+
+    static value_type
+    load_reversed(double const* ptr)
+    {
+        auto const low  = _mm_loadu_pd(ptr + 2);
+        auto const high = _mm_loadu_pd(ptr);
+        return {_mm_shuffle_pd(low, low, 1), _mm_shuffle_pd(high, high, 1)};
+    }
+
+    static value_type
+    add(value_type a, value_type b)
+    {
+        return {_mm_add_pd(a.low, b.low), _mm_add_pd(a.high, b.high)};
+    }
+
+    static value_type
+    mul(value_type a, value_type b)
+    {
+        return {_mm_mul_pd(a.low, b.low), _mm_mul_pd(a.high, b.high)};
+    }
+
+    static void
+    store(double* ptr, value_type value)
+    {
+        _mm_storeu_pd(ptr, value.low);
+        _mm_storeu_pd(ptr + 2, value.high);
+    }
+#else
+    using value_type = std::array<double, 4>;
+
+    static value_type
+    zero()
+    {
+        return {};
+    }
+
+    static value_type
+    broadcast(double value)
+    {
+        return {value, value, value, value};
+    }
+
+    static value_type
+    load(double const* ptr)
+    {
+        return {ptr[0], ptr[1], ptr[2], ptr[3]};
+    }
+
+    static value_type
+    load_reversed(double const* ptr)
+    {
+        return {ptr[3], ptr[2], ptr[1], ptr[0]};
+    }
+
+    static value_type
+    add(value_type a, value_type b)
+    {
+        return {a[0] + b[0], a[1] + b[1], a[2] + b[2], a[3] + b[3]};
+    }
+
+    static value_type
+    mul(value_type a, value_type b)
+    {
+        return {a[0] * b[0], a[1] * b[1], a[2] * b[2], a[3] * b[3]};
+    }
+
+    static void
+    store(double* ptr, value_type value)
+    {
+        std::copy(value.begin(), value.end(), ptr);
+    }
+#endif
+};
+
+}    // namespace detail
+
 template <std::size_t Order>
-class filter : public circular_buffer<double, Order> {
-    using circular_buffer<double, Order>::begin;
-    using circular_buffer<double, Order>::end;
-    using circular_buffer<double, Order>::full;
+class filter : public delay_line<double, Order> {
+    using delay_line<double, Order>::begin;
+    using delay_line<double, Order>::end;
+    using delay_line<double, Order>::full;
 
 protected:
     /**
@@ -217,7 +384,9 @@ public:
      * Constructs a filter with the given table data
      * @param table_data the table data to use for the filter
      */
-    constexpr explicit filter(std::array<double, Order> const& table_data) : table_{table_data} {}
+    constexpr explicit filter(std::array<double, Order> const& table_data)
+        : table_{table_data}, symmetric_{is_symmetric(table_data)}
+    {}
 
     /**
      * Constructs a filter with the given table data and data
@@ -225,7 +394,7 @@ public:
      * @param data the data to filter
      */
     constexpr filter(std::array<double, Order> const& table_data, std::array<double, Order> const& data)
-        : table_{table_data}
+        : table_{table_data}, symmetric_{is_symmetric(table_data)}
     {
         (*this) << data;
     }
@@ -235,7 +404,8 @@ public:
      * @param table_data the table data to use for the filter
      * @param data the rvalue data to filter
      */
-    filter(std::array<double, Order> const& table_data, std::array<double, Order> const&& data) : table_{table_data}
+    filter(std::array<double, Order> const& table_data, std::array<double, Order> const&& data)
+        : table_{table_data}, symmetric_{is_symmetric(table_data)}
     {
         (*this) << data;
     }
@@ -250,6 +420,7 @@ public:
             item *= *other_ptr;
             other_ptr++;
         }
+        symmetric_ = is_symmetric(table_);
         return *this;
     }
 
@@ -263,6 +434,7 @@ public:
             item += *other_ptr;
             other_ptr++;
         }
+        symmetric_ = is_symmetric(table_);
         return *this;
     }
 
@@ -276,6 +448,7 @@ public:
             item -= *other_ptr;
             other_ptr++;
         }
+        symmetric_ = is_symmetric(table_);
         return *this;
     }
 
@@ -287,16 +460,63 @@ public:
     double
     value(double val)
     {
-        circular_buffer<double, Order>::push(val);
+        delay_line<double, Order>::push(val);
         if (!full())
             return 0.;
-        auto   it      = begin();
-        double ret_val = 0.;
-        for (auto& item : table_) {
-            ret_val += item * (*it);
-            it++;
+        return symmetric_ ? dot<true>(begin()) : dot<false>(begin());
+    }
+
+    /**
+     * Applies the filter to a block of data points, out[n] is what value(in[n]) would return.
+     * The history and the block are laid out linearly, so every group of outputs is a plain dot product that
+     * loads each coefficient once for block_outputs outputs.
+     * @param in the new data points
+     * @param out the filtered data points
+     * @return the number of processed data points, the smaller of both sizes
+     */
+    std::size_t
+    process(std::span<double const> in, std::span<double> out)
+    {
+        auto const size = std::min(in.size(), out.size());
+        // History (at most Order - 1 samples) followed by a chunk of the block
+        std::array<double, Order - 1 + block_chunk> line;
+        std::size_t                                 history{};
+        for (auto it = begin(); it != end(); it++) {
+            line[history++] = *it;
         }
-        return ret_val;
+        if (history == Order) {
+            std::copy(line.begin() + 1, line.begin() + Order, line.begin());
+            history--;
+        }
+        for (std::size_t done{}; done < size;) {
+            auto const chunk = std::min(block_chunk, size - done);
+            std::copy_n(in.begin() + done, chunk, line.begin() + history);
+            auto const total = history + chunk;
+            // Outputs before the line holds Order samples are zero, as while the buffer is filling up
+            std::size_t n{};
+            for (; (n < chunk) && (history + n + 1 < Order); n++) {
+                out[done + n] = 0.;
+            }
+            // The window of output n ends at the data point n of the chunk
+            auto const window = [&line, history](std::size_t n) { return &line[history + n + 1 - Order]; };
+            for (; n + block_outputs <= chunk; n += block_outputs) {
+                if (symmetric_) {
+                    dot_block<true>(window(n), &out[done + n], std::make_index_sequence<block_outputs>{});
+                } else {
+                    dot_block<false>(window(n), &out[done + n], std::make_index_sequence<block_outputs>{});
+                }
+            }
+            for (; n < chunk; n++) {
+                out[done + n] = symmetric_ ? dot<true>(window(n)) : dot<false>(window(n));
+            }
+            history = std::min(total, Order - 1);
+            std::copy(line.begin() + (total - history), line.begin() + total, line.begin());
+            done += chunk;
+        }
+        for (auto i = size - std::min(size, Order); i < size; i++) {
+            delay_line<double, Order>::push(in[i]);
+        }
+        return size;
     }
 
     /**
@@ -305,7 +525,7 @@ public:
     void
     reset()
     {
-        circular_buffer<double, Order>::clear();
+        delay_line<double, Order>::clear();
     }
 
     /**
@@ -318,12 +538,224 @@ public:
         return table_;
     }
 
+    /**
+     * Tells whether the table is symmetric, h[i] == h[Order - 1 - i], so value() and process() use the folded
+     * form h[i] * (x[i] + x[Order - 1 - i]) with half the multiplies. Checked whenever the table changes.
+     * @return true for a symmetric table
+     */
+    [[nodiscard]] bool
+    symmetric() const
+    {
+        return symmetric_;
+    }
+
 private:
+    using lane_ops = detail::lane_ops;
+
+    static constexpr std::size_t block_chunk   = 256;
+    static constexpr std::size_t block_outputs = 8;
+    static constexpr std::size_t fold          = Order / 2;    // coefficient pairs of a symmetric table
+
     std::array<double, Order> table_;
+    bool                      symmetric_;
+
+    static constexpr bool
+    is_symmetric(std::array<double, Order> const& table)
+    {
+        for (std::size_t i{}; i < fold; i++) {
+            if (table[i] != table[Order - 1 - i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Terms of the dot product: coefficient pairs of a folded table, single coefficients otherwise
+    template <bool Fold>
+    static constexpr std::size_t terms = Fold ? fold : Order;
+
+    // Terms summed in four interleaved lanes, lane j holds the terms i = j (mod 4)
+    template <bool Fold>
+    static constexpr std::size_t lane_terms = terms<Fold> / 4 * 4;
+
+    // The terms left over by the lanes and the middle coefficient of an odd folded table, added to the lane sum
+    template <bool Fold>
+    double
+    dot_tail(double const* window, double sum) const
+    {
+        for (auto i = lane_terms<Fold>; i < terms<Fold>; i++) {
+            sum += table_[i] * (Fold ? window[i] + window[Order - 1 - i] : window[i]);
+        }
+        if constexpr (Fold && (Order % 2 != 0)) {
+            sum += table_[fold] * window[fold];
+        }
+        return sum;
+    }
+
+    // One output over a contiguous window, the far half of a folded table is read reversed
+    template <bool Fold>
+    double
+    dot(double const* window) const
+    {
+        auto sum = lane_ops::zero();
+        for (std::size_t i{}; i < lane_terms<Fold>; i += 4) {
+            auto samples = lane_ops::load(window + i);
+            if constexpr (Fold) {
+                samples = lane_ops::add(samples, lane_ops::load_reversed(window + Order - 4 - i));
+            }
+            sum = lane_ops::add(sum, lane_ops::mul(lane_ops::load(&table_[i]), samples));
+        }
+        std::array<double, 4> lanes;
+        lane_ops::store(lanes.data(), sum);
+        return dot_tail<Fold>(window, (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]));
+    }
+
+    // block_outputs consecutive outputs, every coefficient is broadcast against a vector of outputs. The terms are
+    // summed in the same lanes as dot(), so value() and process() agree to the last bit, and both halves of a pair
+    // are plain loads here. Accumulator Index holds lane Index / groups of the output vector Index % groups, the
+    // fold over the indices keeps all of them in registers.
+    template <bool Fold, std::size_t... Index>
+    void
+    dot_block(double const* window, double* out, std::index_sequence<Index...>) const
+    {
+        constexpr std::size_t groups = block_outputs / 4;
+        static_assert(sizeof...(Index) == 4 * groups);
+        lane_ops::value_type sum[sizeof...(Index)]{(void(Index), lane_ops::zero())...};
+        for (std::size_t i{}; i < lane_terms<Fold>; i += 4) {
+            auto const update = [&](lane_ops::value_type& item, std::size_t j, std::size_t g) {
+                auto samples = lane_ops::load(window + i + j + 4 * g);
+                if constexpr (Fold) {
+                    samples = lane_ops::add(samples, lane_ops::load(window + Order - 1 - i - j + 4 * g));
+                }
+                item = lane_ops::add(item, lane_ops::mul(lane_ops::broadcast(table_[i + j]), samples));
+            };
+            (update(sum[Index], Index / groups, Index % groups), ...);
+        }
+        for (std::size_t g{}; g < groups; g++) {
+            std::array<std::array<double, 4>, 4> lanes;
+            for (std::size_t j{}; j < 4; j++) {
+                lane_ops::store(lanes[j].data(), sum[j * groups + g]);
+            }
+            for (std::size_t k{}; k < 4; k++) {
+                auto const n = 4 * g + k;
+                out[n] = dot_tail<Fold>(window + n, (lanes[0][k] + lanes[1][k]) + (lanes[2][k] + lanes[3][k]));
+            }
+        }
+    }
 };
 
+/**
+ * FIR filter with an FFT overlap-save block path for long coefficient tables.
+ * value() stays the direct form, process() filters step new samples per pair of real fft_size transforms against
+ * the precomputed coefficient spectrum, so a block costs O(log Order) per sample instead of O(Order).
+ * Short blocks, where the transforms would not pay off, use the direct block kernel.
+ */
+template <std::size_t Order>
+class overlap_save : public filter<Order> {
+public:
+    static constexpr std::size_t fft_size = 4 * std::bit_ceil(Order);
+    static constexpr std::size_t step     = fft_size - Order + 1;
+
+    /**
+     * Constructs a filter with the given table data
+     * @param table_data the table data to use for the filter
+     */
+    explicit overlap_save(std::array<double, Order> const& table_data)
+        : filter<Order>{table_data}, plan_{fft_real_plan<double>::cached(fft_size)}, spectrum_(bins), work_(bins),
+          line_(Order - 1 + step), signal_(fft_size)
+    {}
+
+    /**
+     * Constructs a filter with the given table data and data
+     * @param table_data the table data to use for the filter
+     * @param data the data to filter
+     */
+    overlap_save(std::array<double, Order> const& table_data, std::array<double, Order> const& data)
+        : filter<Order>{table_data, data}, plan_{fft_real_plan<double>::cached(fft_size)}, spectrum_(bins),
+          work_(bins), line_(Order - 1 + step), signal_(fft_size)
+    {}
+
+    /**
+     * Applies the filter to a block of data points, out[n] is what value(in[n]) would return up to rounding
+     * @param in the new data points
+     * @param out the filtered data points
+     * @return the number of processed data points, the smaller of both sizes
+     */
+    std::size_t
+    process(std::span<double const> in, std::span<double> out)
+    {
+        auto const size = std::min(in.size(), out.size());
+        if (size < step / 4) {
+            return filter<Order>::process(in, out);
+        }
+        if (auto const table = filter<Order>::table(); table != coefficients_) {
+            prepare(table);
+        }
+        // The history is right aligned in front of the new samples, missing samples are zeros
+        auto const history = delay_line<double, Order>::size();
+        auto const kept    = std::min(history, Order - 1);
+        std::fill(line_.begin(), line_.end(), 0.);
+        std::copy(delay_line<double, Order>::end() - kept, delay_line<double, Order>::end(),
+                  line_.begin() + (Order - 1 - kept));
+        for (std::size_t done{}; done < size;) {
+            auto const chunk = std::min(step, size - done);
+            std::copy_n(in.begin() + done, chunk, line_.begin() + (Order - 1));
+            std::copy_n(line_.begin(), Order - 1 + chunk, signal_.begin());
+            std::fill(signal_.begin() + (Order - 1 + chunk), signal_.end(), 0.);
+            plan_->forward(signal_.data(), work_.data());
+            for (std::size_t i{}; i < bins; i++) {
+                work_[i] = std::complex<double>{
+                    work_[i].real() * spectrum_[i].real() - work_[i].imag() * spectrum_[i].imag(),
+                    work_[i].real() * spectrum_[i].imag() + work_[i].imag() * spectrum_[i].real()};
+            }
+            plan_->inverse(work_.data(), signal_.data(), work_.data());
+            for (std::size_t n{}; n < chunk; n++) {
+                // Outputs before Order samples were seen are zero, as while the buffer is filling up
+                out[done + n] = (history + done + n + 1 < Order) ? 0. : signal_[Order - 1 + n];
+            }
+            std::copy_n(line_.begin() + chunk, Order - 1, line_.begin());
+            done += chunk;
+        }
+        for (auto i = size - std::min(size, Order); i < size; i++) {
+            delay_line<double, Order>::push(in[i]);
+        }
+        return size;
+    }
+
+private:
+    static constexpr std::size_t bins = fft_size / 2 + 1;
+
+    std::shared_ptr<fft_real_plan<double> const> plan_;
+    std::vector<std::complex<double>>            spectrum_;
+    std::vector<std::complex<double>>            work_;
+    std::vector<double>                          line_;
+    std::vector<double>                          signal_;
+    std::array<double, Order>                    coefficients_{};
+
+    // Spectrum of the time reversed table, so the circular convolution yields the filter's dot products
+    void
+    prepare(std::array<double, Order> const& table)
+    {
+        coefficients_ = table;
+        std::fill(signal_.begin(), signal_.end(), 0.);
+        for (std::size_t i{}; i < Order; i++) {
+            signal_[i] = table[Order - 1 - i];
+        }
+        plan_->forward(signal_.data(), spectrum_.data());
+    }
+};
+
+/// Coefficient tables longer than this use the overlap-save block path
+inline constexpr std::size_t fft_filter_threshold = 64;
+
+/**
+ * The filter implementation picked by table size: direct form up to fft_filter_threshold taps, overlap-save above
+ */
+template <std::size_t Size>
+using fir_engine = std::conditional_t<(Size > fft_filter_threshold), overlap_save<Size>, filter<Size>>;
+
 template <std::size_t Order, std::size_t Cutoff, std::size_t Sampling>
-class lowpass : public filter<Order + 1> {
+class lowpass : public fir_engine<Order + 1> {
 public:
     /**
      * Creates a lowpass filter with the given cutoff frequency and sampling rate
@@ -351,14 +783,14 @@ public:
     /**
      * Constructs a lowpass filter with the given cutoff frequency and sampling rate
      */
-    constexpr lowpass() : filter<Order + 1>{prepare_table()} {}
+    constexpr lowpass() : fir_engine<Order + 1>{prepare_table()} {}
 
     /**
      * Constructs a lowpass filter with the given cutoff frequency and sampling rate, and applies it to the given data
      * @param data the data to filter
      */
     template <std::size_t N>
-    constexpr explicit lowpass(std::array<double, N> const& data) : filter<Order + 1>{prepare_table(), data}
+    constexpr explicit lowpass(std::array<double, N> const& data) : fir_engine<Order + 1>{prepare_table(), data}
     {}
 
     /**
@@ -366,7 +798,7 @@ public:
      * @param data the data to filter
      */
     template <std::size_t N>
-    constexpr explicit lowpass(std::array<double, N> const&& data) : filter<Order + 1>{prepare_table(), data}
+    constexpr explicit lowpass(std::array<double, N> const&& data) : fir_engine<Order + 1>{prepare_table(), data}
     {}
 
     /**
@@ -381,7 +813,7 @@ public:
 };
 
 template <std::size_t Order, std::size_t Cutoff, std::size_t Sampling>
-class highpass : public filter<Order + 1> {
+class highpass : public fir_engine<Order + 1> {
 public:
     /**
      * Creates a highpass filter with the given cutoff frequency and sampling rate
@@ -410,14 +842,14 @@ public:
     /**
      * Constructs a highpass filter with the given cutoff frequency and sampling rate
      */
-    highpass() : filter<Order + 1>{prepare_table()} {}
+    highpass() : fir_engine<Order + 1>{prepare_table()} {}
 
     /**
      * Constructs a highpass filter with the given cutoff frequency and sampling rate, and applies it to the given data
      * @param data the data to filter
      */
     template <std::size_t N>
-    explicit highpass(std::array<double, N> const& data) : filter<Order + 1>{prepare_table(), data}
+    explicit highpass(std::array<double, N> const& data) : fir_engine<Order + 1>{prepare_table(), data}
     {}
 
     /**
@@ -425,7 +857,7 @@ public:
      * @param data the data to filter
      */
     template <std::size_t N>
-    explicit highpass(std::array<double, N> const&& data) : filter<Order + 1>{prepare_table(), data}
+    explicit highpass(std::array<double, N> const&& data) : fir_engine<Order + 1>{prepare_table(), data}
     {}
 
     /**
@@ -440,7 +872,7 @@ public:
 };
 
 template <std::size_t Order, std::size_t LowerCutoff, std::size_t HigherCutoff, std::size_t Sampling>
-class bandstop : public filter<Order + 1> {
+class bandstop : public fir_engine<Order + 1> {
 public:
     /**
      * Creates a table of coefficients for a bandstop FIR filter with the given cutoff frequencies and sampling rate.
@@ -470,7 +902,7 @@ public:
     /**
      * Constructs a bandstop FIR filter with the given cutoff frequencies and sampling rate.
      */
-    bandstop() : filter<Order + 1>{prepare_table()} {}
+    bandstop() : fir_engine<Order + 1>{prepare_table()} {}
 
     /**
      * Constructs a bandstop FIR filter with the given cutoff frequencies and sampling rate, and applies it to the given
@@ -478,7 +910,7 @@ public:
      * @param data the data to filter
      */
     template <std::size_t N>
-    explicit bandstop(std::array<double, N> const& data) : filter<Order + 1>{prepare_table(), data}
+    explicit bandstop(std::array<double, N> const& data) : fir_engine<Order + 1>{prepare_table(), data}
     {}
 
     /**
@@ -487,7 +919,7 @@ public:
      * @param data the data to filter
      */
     template <std::size_t N>
-    explicit bandstop(std::array<double, N> const&& data) : filter<Order + 1>{prepare_table(), data}
+    explicit bandstop(std::array<double, N> const&& data) : fir_engine<Order + 1>{prepare_table(), data}
     {}
 
     /**
@@ -502,7 +934,7 @@ public:
 };
 
 template <std::size_t Order, std::size_t LowerCutoff, std::size_t HigherCutoff, std::size_t Sampling>
-class bandpass : public filter<Order + 1> {
+class bandpass : public fir_engine<Order + 1> {
 public:
     /**
      * Creates a table of coefficients for a bandpass FIR filter with the given cutoff frequencies and sampling rate.
@@ -527,7 +959,7 @@ public:
     /**
      * Constructs a bandpass FIR filter with the given cutoff frequencies and sampling rate.
      */
-    bandpass() : filter<Order + 1>{prepare_table()} {}
+    bandpass() : fir_engine<Order + 1>{prepare_table()} {}
 
     /**
      * Constructs a bandpass FIR filter with the given cutoff frequencies and sampling rate, and applies it to the given
@@ -535,7 +967,7 @@ public:
      * @param data the data to filter
      */
     template <std::size_t N>
-    explicit bandpass(std::array<double, N> const& data) : filter<Order + 1>{prepare_table(), data}
+    explicit bandpass(std::array<double, N> const& data) : fir_engine<Order + 1>{prepare_table(), data}
     {}
 
     /**
@@ -544,7 +976,7 @@ public:
      * @param data the data to filter
      */
     template <std::size_t N>
-    explicit bandpass(std::array<double, N> const&& data) : filter<Order + 1>{prepare_table(), data}
+    explicit bandpass(std::array<double, N> const&& data) : fir_engine<Order + 1>{prepare_table(), data}
     {}
 
     /**
@@ -559,7 +991,7 @@ public:
 };
 
 template <std::size_t Order>
-class moving_average : public filter<Order> {
+class moving_average : public fir_engine<Order> {
     /**
      * Prepares the filter table data
      * @return the filter table data
@@ -578,14 +1010,14 @@ public:
     /**
      * Constructs a moving average filter with the given order
      */
-    moving_average() : filter<Order>{prepare_table()} {}
+    moving_average() : fir_engine<Order>{prepare_table()} {}
 
     /**
      * Constructs a moving average filter with the given order and applies it to the given data
      * @param data the data to filter
      */
     template <std::size_t N>
-    explicit moving_average(std::array<double, N> const& data) : filter<Order>{prepare_table(), data}
+    explicit moving_average(std::array<double, N> const& data) : fir_engine<Order>{prepare_table(), data}
     {}
 
     /**
@@ -593,7 +1025,7 @@ public:
      * @param data the data to filter
      */
     template <std::size_t N>
-    explicit moving_average(std::array<double, N> const&& data) : filter<Order>{prepare_table(), data}
+    explicit moving_average(std::array<double, N> const&& data) : fir_engine<Order>{prepare_table(), data}
     {}
 
     /**
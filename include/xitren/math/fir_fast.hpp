@@ -1,22 +1,31 @@
 #pragma once
 
-#include <xitren/circular_buffer.hpp>
+#include <xitren/math/delay_line.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstdint>
 #include <cstring>
+#include <limits>
+#include <span>
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#    include <immintrin.h>
+#elif defined(__SSE2__)
+#    include <emmintrin.h>
+#endif
 
 namespace xitren::math {
 
 template <std::size_t Order>
-class filter : public containers::circular_buffer<std::uint32_t, Order> {
+class filter : public delay_line<std::uint32_t, Order> {
     static constexpr std::uint32_t power_  = 20;
     static constexpr double        factor_ = static_cast<double>(1 << power_);
 
-    using containers::circular_buffer<std::uint32_t, Order>::begin;
-    using containers::circular_buffer<std::uint32_t, Order>::end;
-    using containers::circular_buffer<std::uint32_t, Order>::full;
+    using delay_line<std::uint32_t, Order>::begin;
+    using delay_line<std::uint32_t, Order>::end;
+    using delay_line<std::uint32_t, Order>::full;
 
 public:
     /**
@@ -96,14 +105,13 @@ public:
     std::uint32_t
     value(std::uint32_t val)
     {
-        containers::circular_buffer<std::uint32_t, Order>::push(val);
+        delay_line<std::uint32_t, Order>::push(val);
         if (!full())
             return 0;
-        auto          it      = begin();
-        std::uint64_t ret_val = 0;
-        for (auto& item : table_) {
-            ret_val += item * (*it);
-            it++;
+        std::uint32_t const* window  = begin();
+        std::uint64_t        ret_val = 0;
+        for (std::size_t i{}; i < Order; i++) {
+            ret_val += table_[i] * window[i];
         }
         ret_val = ret_val >> power_;
         return static_cast<std::uint32_t>(ret_val);
@@ -115,7 +123,7 @@ public:
     void
     reset()
     {
-        containers::circular_buffer<std::uint32_t, Order>::clear();
+        delay_line<std::uint32_t, Order>::clear();
     }
 
     /**
@@ -142,6 +150,317 @@ private:
     }
 };
 
+namespace detail {
+
+/**
+ * Rounds a value to Q15, saturating to [-1, 1 - 2^-15]
+ * @param value the value
+ * @return the Q15 value
+ */
+inline std::int16_t
+to_q15(double value)
+{
+    auto const scaled = std::nearbyint(value * 32768.);
+    return static_cast<std::int16_t>(std::clamp(scaled, -32768., 32767.));
+}
+
+/**
+ * Rounds a value to Q31, saturating to [-1, 1 - 2^-31]
+ * @param value the value
+ * @return the Q31 value
+ */
+inline std::int32_t
+to_q31(double value)
+{
+    auto const scaled = std::nearbyint(value * 2147483648.);
+    return static_cast<std::int32_t>(std::clamp(scaled, -2147483648., 2147483647.));
+}
+
+/**
+ * Dot product of int16 vectors in int32, 32 / 16 / 8 products per instruction with VNNI / AVX2 / SSE2.
+ * Exact when the sum of |a[i] * b[i]| stays below 2^31: every partial sum is bounded by it.
+ */
+inline std::int32_t
+dot_q15(std::int16_t const* a, std::int16_t const* b, std::size_t size)
+{
+    std::size_t  i{};
+    std::int32_t sum{};
+#if defined(__AVX512VNNI__) && defined(__AVX512BW__)
+    __m512i wide = _mm512_setzero_si512();
+    for (; i + 32 <= size; i += 32) {
+        wide = _mm512_dpwssd_epi32(wide, _mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+    }
+    std::int32_t lanes[16];
+    _mm512_storeu_si512(lanes, wide);
+    for (auto const lane : lanes) {
+        sum += lane;
+    }
+#endif
+#if defined(__AVX2__)
+    __m256i acc = _mm256_setzero_si256();
+    for (; i + 16 <= size; i += 16) {
+        auto const x = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(a + i));
+        auto const y = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(b + i));
+        acc          = _mm256_add_epi32(acc, _mm256_madd_epi16(x, y));
+    }
+    auto half = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+#elif defined(__SSE2__)
+    auto half = _mm_setzero_si128();
+#endif
+#if defined(__SSE2__)
+    for (; i + 8 <= size; i += 8) {
+        auto const x = _mm_loadu_si128(reinterpret_cast<__m128i const*>(a + i));
+        auto const y = _mm_loadu_si128(reinterpret_cast<__m128i const*>(b + i));
+        half         = _mm_add_epi32(half, _mm_madd_epi16(x, y));
+    }
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4e));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0xb1));
+    sum += _mm_cvtsi128_si32(half);
+#endif
+    for (; i < size; i++) {
+        sum += static_cast<std::int32_t>(a[i]) * b[i];
+    }
+    return sum;
+}
+
+/**
+ * Dot product of int32 vectors in int64, 4 / 2 products per instruction with AVX2 / SSE4.1.
+ * Exact when the sum of |a[i] * b[i]| stays below 2^63.
+ */
+inline std::int64_t
+dot_q31(std::int32_t const* a, std::int32_t const* b, std::size_t size)
+{
+    std::size_t  i{};
+    std::int64_t sum{};
+#if defined(__AVX2__)
+    __m256i acc = _mm256_setzero_si256();
+    for (; i + 8 <= size; i += 8) {
+        auto const x = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(a + i));
+        auto const y = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(b + i));
+        // mul_epi32 takes the even lanes, the odd ones are shifted down to them
+        acc = _mm256_add_epi64(acc, _mm256_mul_epi32(x, y));
+        acc = _mm256_add_epi64(acc, _mm256_mul_epi32(_mm256_srli_epi64(x, 32), _mm256_srli_epi64(y, 32)));
+    }
+    auto half = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+#elif defined(__SSE4_1__)
+    auto half = _mm_setzero_si128();
+    for (; i + 4 <= size; i += 4) {
+        auto const x = _mm_loadu_si128(reinterpret_cast<__m128i const*>(a + i));
+        auto const y = _mm_loadu_si128(reinterpret_cast<__m128i const*>(b + i));
+        half         = _mm_add_epi64(half, _mm_mul_epi32(x, y));
+        half         = _mm_add_epi64(half, _mm_mul_epi32(_mm_srli_epi64(x, 32), _mm_srli_epi64(y, 32)));
+    }
+#endif
+#if defined(__AVX2__) || defined(__SSE4_1__)
+    std::int64_t lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), half);
+    sum += lanes[0] + lanes[1];
+#endif
+    for (; i < size; i++) {
+        sum += static_cast<std::int64_t>(a[i]) * b[i];
+    }
+    return sum;
+}
+
+/**
+ * Rounds a fixed point sum to nearest and saturates it to the sample type
+ * @param sum the sum of products, Shift fraction bits above the sample type
+ * @return the sample
+ */
+template <class Sample, unsigned Shift>
+constexpr Sample
+round_q(std::int64_t sum)
+{
+    auto const value = (sum + (std::int64_t{1} << (Shift - 1))) >> Shift;
+    return static_cast<Sample>(std::clamp<std::int64_t>(value, std::numeric_limits<Sample>::min(),
+                                                        std::numeric_limits<Sample>::max()));
+}
+
+}    // namespace detail
+
+/**
+ * Signed Q15 FIR filter: int16 samples and coefficients, rounded to nearest and saturated output.
+ * Samples are at most 2^15 in magnitude, so while the L1 norm of the table is below 2 (2^16 in Q15) no partial sum
+ * of products can leave int32, then the whole dot product runs in pmaddwd / vpdpwssd style int32 kernels. Larger
+ * gains fall back to exact int64 accumulation, so the output is always the saturated, rounded exact result.
+ */
+template <std::size_t Order>
+class filter_q15 : public delay_line<std::int16_t, Order> {
+    using line = delay_line<std::int16_t, Order>;
+
+public:
+    /**
+     * Constructs a filter with the given table data
+     * @param table_data the table data, rounded to Q15 and saturated
+     */
+    explicit filter_q15(std::array<double, Order> const& table_data)
+    {
+        std::int64_t norm{};
+        for (std::size_t i{}; i < Order; i++) {
+            table_[i] = detail::to_q15(table_data[i]);
+            norm += std::abs(table_[i]);
+        }
+        headroom_ = norm < (1 << 16);
+    }
+
+    /**
+     * Applies the filter to a new data point
+     * @param val the new data point
+     * @return the filtered data point, 0 until the history is full
+     */
+    std::int16_t
+    value(std::int16_t val)
+    {
+        line::push(val);
+        if (!line::full()) {
+            return 0;
+        }
+        std::int16_t const* window = line::begin();
+        if (headroom_) {
+            return detail::round_q<std::int16_t, 15>(detail::dot_q15(table_.data(), window, Order));
+        }
+        std::int64_t sum{};
+        for (std::size_t i{}; i < Order; i++) {
+            sum += static_cast<std::int32_t>(table_[i]) * window[i];
+        }
+        return detail::round_q<std::int16_t, 15>(sum);
+    }
+
+    /**
+     * Applies the filter to a block
+     * @param in the new data points
+     * @param out the filtered data points
+     * @return the number of processed points, the smaller of both sizes
+     */
+    std::size_t
+    process(std::span<std::int16_t const> in, std::span<std::int16_t> out)
+    {
+        auto const size = std::min(in.size(), out.size());
+        for (std::size_t i{}; i < size; i++) {
+            out[i] = value(in[i]);
+        }
+        return size;
+    }
+
+    /**
+     * Resets the filter state
+     */
+    void
+    reset()
+    {
+        line::clear();
+    }
+
+    /**
+     * Returns the filter table data
+     * @return the Q15 table
+     */
+    std::array<std::int16_t, Order>
+    table() const
+    {
+        return table_;
+    }
+
+private:
+    std::array<std::int16_t, Order> table_{};
+    bool                            headroom_{};
+};
+
+/**
+ * Signed Q31 FIR filter: int32 samples and coefficients, rounded to nearest and saturated output.
+ * While the L1 norm of the table is below 2 - 2^-30 the products are summed in int64 lanes, 4 per instruction with
+ * AVX2. Larger gains split every product into its high and low 31 bits and sum them apart, which is exact for
+ * any table without a 128 bit type.
+ */
+template <std::size_t Order>
+class filter_q31 : public delay_line<std::int32_t, Order> {
+    using line = delay_line<std::int32_t, Order>;
+
+public:
+    /**
+     * Constructs a filter with the given table data
+     * @param table_data the table data, rounded to Q31 and saturated
+     */
+    explicit filter_q31(std::array<double, Order> const& table_data)
+    {
+        std::uint64_t norm{};
+        for (std::size_t i{}; i < Order; i++) {
+            table_[i] = detail::to_q31(table_data[i]);
+            norm += static_cast<std::uint64_t>(std::abs(static_cast<std::int64_t>(table_[i])));
+        }
+        headroom_ = norm < (std::uint64_t{1} << 32) - 1;
+    }
+
+    /**
+     * Applies the filter to a new data point
+     * @param val the new data point
+     * @return the filtered data point, 0 until the history is full
+     */
+    std::int32_t
+    value(std::int32_t val)
+    {
+        line::push(val);
+        if (!line::full()) {
+            return 0;
+        }
+        std::int32_t const* window = line::begin();
+        if (headroom_) {
+            return detail::round_q<std::int32_t, 31>(detail::dot_q31(table_.data(), window, Order));
+        }
+        // sum = high * 2^31 + low, so round(sum / 2^31) = high + round(low / 2^31)
+        constexpr std::int64_t mask = (std::int64_t{1} << 31) - 1;
+        std::int64_t           high{};
+        std::int64_t           low{};
+        for (std::size_t i{}; i < Order; i++) {
+            auto const product = static_cast<std::int64_t>(table_[i]) * window[i];
+            high += product >> 31;
+            low += product & mask;
+        }
+        auto const rounded = high + ((low + (std::int64_t{1} << 30)) >> 31);
+        return static_cast<std::int32_t>(std::clamp<std::int64_t>(rounded, std::numeric_limits<std::int32_t>::min(),
+                                                                  std::numeric_limits<std::int32_t>::max()));
+    }
+
+    /**
+     * Applies the filter to a block
+     * @param in the new data points
+     * @param out the filtered data points
+     * @return the number of processed points, the smaller of both sizes
+     */
+    std::size_t
+    process(std::span<std::int32_t const> in, std::span<std::int32_t> out)
+    {
+        auto const size = std::min(in.size(), out.size());
+        for (std::size_t i{}; i < size; i++) {
+            out[i] = value(in[i]);
+        }
+        return size;
+    }
+
+    /**
+     * Resets the filter state
+     */
+    void
+    reset()
+    {
+        line::clear();
+    }
+
+    /**
+     * Returns the filter table data
+     * @return the Q31 table
+     */
+    std::array<std::int32_t, Order>
+    table() const
+    {
+        return table_;
+    }
+
+private:
+    std::array<std::int32_t, Order> table_{};
+    bool                            headroom_{};
+};
+
 template <std::size_t Order, std::size_t Cutoff, std::size_t Sampling>
 class lowpass : public filter<Order + 1> {
 public:
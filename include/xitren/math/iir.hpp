@@ -0,0 +1,779 @@
+#pragma once
+
+#include <xitren/math/filter_bank.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <numbers>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace xitren::math {
+
+/**
+ * Second-order section H(z) = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2)
+ */
+template <class Type>
+struct biquad {
+    Type b0{1};
+    Type b1{};
+    Type b2{};
+    Type a1{};
+    Type a2{};
+};
+
+/// Designed cascades, the sections run in array order
+template <std::size_t Sections>
+using iir_sections = std::array<biquad<double>, Sections>;
+
+namespace detail {
+
+using roots = std::vector<std::complex<double>>;
+
+/**
+ * Filter in zeros, poles and gain form
+ */
+struct iir_zpk {
+    roots  zeros;
+    roots  poles;
+    double gain{1.};
+};
+
+inline std::complex<double>
+product(roots const& items, std::complex<double> shift)
+{
+    std::complex<double> ret{1.};
+    for (auto const& item : items) {
+        ret *= shift - item;
+    }
+    return ret;
+}
+
+/**
+ * Analog Butterworth lowpass with a -3 dB edge at 1 rad/s
+ * @param order the filter order
+ * @return the prototype
+ */
+inline iir_zpk
+butterworth_prototype(std::size_t order)
+{
+    iir_zpk ret;
+    for (std::size_t k{}; k < order; k++) {
+        auto const theta = std::numbers::pi * static_cast<double>(2 * k + order + 1) / static_cast<double>(2 * order);
+        ret.poles.push_back(std::polar(1., theta));
+    }
+    return ret;
+}
+
+/**
+ * Analog Chebyshev type I lowpass, equiripple up to the passband edge at 1 rad/s
+ * @param order the filter order
+ * @param ripple the passband ripple, in dB
+ * @return the prototype
+ */
+inline iir_zpk
+chebyshev_prototype(std::size_t order, double ripple)
+{
+    iir_zpk      ret;
+    double const eps = std::sqrt(std::pow(10., ripple / 10.) - 1.);
+    double const mu  = std::asinh(1. / eps) / static_cast<double>(order);
+    for (std::size_t k{}; k < order; k++) {
+        auto const theta = std::numbers::pi * (2. * static_cast<double>(k) + 1. - static_cast<double>(order))
+                           / static_cast<double>(2 * order);
+        ret.poles.push_back(-std::sinh(std::complex<double>{mu, theta}));
+    }
+    ret.gain = product(ret.poles, 0.).real();
+    if (order % 2 == 0) {
+        ret.gain /= std::sqrt(1. + eps * eps);
+    }
+    return ret;
+}
+
+/*
+ * Elliptic functions through descending Landen transformations, after S. J. Orfanidis, "Lecture Notes on
+ * Elliptic Filter Design": cde and sne evaluate cd(u K, k) and sn(u K, k), acde and asne are their inverses.
+ */
+
+// Descending Landen sequence of the modulus k
+inline std::vector<double>
+landen(double k)
+{
+    std::vector<double> ret;
+    while ((k > 1e-16) && (ret.size() < 32)) {
+        k = std::pow(k / (1. + std::sqrt(1. - k * k)), 2.);
+        ret.push_back(k);
+    }
+    return ret;
+}
+
+// Complete elliptic integral of the first kind
+inline double
+ellipk(double k)
+{
+    double ret{std::numbers::pi / 2};
+    for (auto item : landen(k)) {
+        ret *= 1. + item;
+    }
+    return ret;
+}
+
+inline std::complex<double>
+cde(std::complex<double> u, double k)
+{
+    auto const v   = landen(k);
+    auto       ret = std::cos(u * std::numbers::pi / 2.);
+    for (auto it = v.rbegin(); it != v.rend(); it++) {
+        ret = (1. + *it) * ret / (1. + *it * ret * ret);
+    }
+    return ret;
+}
+
+inline std::complex<double>
+sne(std::complex<double> u, double k)
+{
+    auto const v   = landen(k);
+    auto       ret = std::sin(u * std::numbers::pi / 2.);
+    for (auto it = v.rbegin(); it != v.rend(); it++) {
+        ret = (1. + *it) * ret / (1. + *it * ret * ret);
+    }
+    return ret;
+}
+
+// Symmetric remainder, in [-y / 2, y / 2]
+inline double
+srem(double x, double y)
+{
+    return x - y * std::round(x / y);
+}
+
+inline std::complex<double>
+acde(std::complex<double> w, double k)
+{
+    auto const v = landen(k);
+    for (std::size_t n{}; n < v.size(); n++) {
+        double const previous = (n == 0) ? k : v[n - 1];
+        w                     = w / (1. + std::sqrt(1. - w * w * previous * previous)) * 2. / (1. + v[n]);
+    }
+    auto const   u     = 2. / std::numbers::pi * std::acos(w);
+    double const ratio = ellipk(std::sqrt(1. - k * k)) / ellipk(k);
+    return {srem(u.real(), 4.), srem(u.imag(), 2. * ratio)};
+}
+
+inline std::complex<double>
+asne(std::complex<double> w, double k)
+{
+    return 1. - acde(w, k);
+}
+
+// Solves the degree equation for the selectivity modulus k from the discrimination modulus k1
+inline double
+ellipdeg(std::size_t order, double k1)
+{
+    double const k1p = std::sqrt(1. - k1 * k1);
+    double       kp  = std::pow(k1p, static_cast<double>(order));
+    for (std::size_t i{1}; i <= order / 2; i++) {
+        auto const u = static_cast<double>(2 * i - 1) / static_cast<double>(order);
+        kp *= std::pow(sne(u, k1p).real(), 4.);
+    }
+    return std::sqrt(1. - kp * kp);
+}
+
+/**
+ * Analog elliptic lowpass, equiripple in both bands, passband edge at 1 rad/s
+ * @param order the filter order
+ * @param ripple the passband ripple, in dB
+ * @param attenuation the minimal stopband attenuation, in dB
+ * @return the prototype
+ */
+inline iir_zpk
+elliptic_prototype(std::size_t order, double ripple, double attenuation)
+{
+    iir_zpk                    ret;
+    double const               ep = std::sqrt(std::pow(10., ripple / 10.) - 1.);
+    double const               es = std::sqrt(std::pow(10., attenuation / 10.) - 1.);
+    double const               k1 = ep / es;
+    double const               k  = ellipdeg(order, k1);
+    std::complex<double> const j{0., 1.};
+    auto const                 v0 = -j * asne(j / ep, k1) / static_cast<double>(order);
+    for (std::size_t i{1}; i <= order / 2; i++) {
+        auto const u    = static_cast<double>(2 * i - 1) / static_cast<double>(order);
+        auto const zero = j / (k * cde(u, k));
+        auto const pole = j * cde(u - j * v0, k);
+        ret.zeros.insert(ret.zeros.end(), {zero, std::conj(zero)});
+        ret.poles.insert(ret.poles.end(), {pole, std::conj(pole)});
+    }
+    if (order % 2 != 0) {
+        ret.poles.push_back((j * sne(j * v0, k)).real());
+    }
+    double const dc = (order % 2 != 0) ? 1. : 1. / std::sqrt(1. + ep * ep);
+    ret.gain        = dc * (product(ret.poles, 0.) / product(ret.zeros, 0.)).real();
+    return ret;
+}
+
+// Frequency transformations of a prototype, analog frequencies are prewarped: w = tan(pi f / fs)
+inline iir_zpk
+to_lowpass(iir_zpk zpk, double w)
+{
+    for (auto& item : zpk.zeros) {
+        item *= w;
+    }
+    for (auto& item : zpk.poles) {
+        item *= w;
+    }
+    zpk.gain *= std::pow(w, static_cast<double>(zpk.poles.size() - zpk.zeros.size()));
+    return zpk;
+}
+
+inline iir_zpk
+to_highpass(iir_zpk zpk, double w)
+{
+    auto const degree = zpk.poles.size() - zpk.zeros.size();
+    zpk.gain *= (product(zpk.zeros, 0.) / product(zpk.poles, 0.)).real();
+    for (auto& item : zpk.zeros) {
+        item = w / item;
+    }
+    for (auto& item : zpk.poles) {
+        item = w / item;
+    }
+    zpk.zeros.insert(zpk.zeros.end(), degree, 0.);
+    return zpk;
+}
+
+inline iir_zpk
+to_bandpass(iir_zpk zpk, double center, double bandwidth)
+{
+    auto const degree = zpk.poles.size() - zpk.zeros.size();
+    auto const split  = [center, bandwidth](roots const& items) {
+        roots ret;
+        for (auto const& item : items) {
+            auto const scaled = item * bandwidth / 2.;
+            auto const offset = std::sqrt(scaled * scaled - center * center);
+            ret.insert(ret.end(), {scaled + offset, scaled - offset});
+        }
+        return ret;
+    };
+    zpk.zeros = split(zpk.zeros);
+    zpk.poles = split(zpk.poles);
+    zpk.zeros.insert(zpk.zeros.end(), degree, 0.);
+    zpk.gain *= std::pow(bandwidth, static_cast<double>(degree));
+    return zpk;
+}
+
+// s = (z - 1) / (z + 1), zeros at infinity move to Nyquist
+inline iir_zpk
+bilinear(iir_zpk zpk)
+{
+    auto const degree = zpk.poles.size() - zpk.zeros.size();
+    zpk.gain *= (product(zpk.zeros, 1.) / product(zpk.poles, 1.)).real();
+    for (auto& item : zpk.zeros) {
+        item = (1. + item) / (1. - item);
+    }
+    for (auto& item : zpk.poles) {
+        item = (1. + item) / (1. - item);
+    }
+    zpk.zeros.insert(zpk.zeros.end(), degree, -1.);
+    return zpk;
+}
+
+// Conjugate pairs, then the real roots two by two, the real roots are paired from both ends of the sorted list
+// so zeros at +1 and -1 share a section
+inline std::vector<std::array<std::complex<double>, 2>>
+root_pairs(roots items)
+{
+    constexpr double tolerance = 1e-9;
+
+    std::vector<std::array<std::complex<double>, 2>> ret;
+    std::vector<double>                               reals;
+    for (auto const& item : items) {
+        if (std::abs(item.imag()) <= tolerance * std::max(1., std::abs(item))) {
+            reals.push_back(item.real());
+        } else if (item.imag() > 0) {
+            ret.push_back({item, std::conj(item)});
+        }
+    }
+    std::sort(reals.begin(), reals.end());
+    for (std::size_t low{}, high{reals.size()}; low < high; low++) {
+        high--;
+        if (low == high) {
+            ret.push_back({reals[low], 0.});
+            break;
+        }
+        ret.push_back({reals[low], reals[high]});
+    }
+    return ret;
+}
+
+/**
+ * Groups a digital filter into second-order sections. Pole pairs closest to the unit circle pick the nearest
+ * zero pair first, the sections run from the least to the most resonant one, the gain is spread evenly.
+ */
+template <std::size_t Sections>
+iir_sections<Sections>
+to_sections(iir_zpk const& zpk)
+{
+    auto poles = root_pairs(zpk.poles);
+    auto zeros = root_pairs(zpk.zeros);
+    std::sort(poles.begin(), poles.end(), [](auto const& a, auto const& b) {
+        return std::max(std::abs(a[0]), std::abs(a[1])) < std::max(std::abs(b[0]), std::abs(b[1]));
+    });
+    std::vector<std::array<std::complex<double>, 2>> matched(poles.size(), {0., 0.});
+    for (auto i = poles.size(); (i-- > 0) && !zeros.empty();) {
+        auto const nearest = std::min_element(zeros.begin(), zeros.end(), [&poles, i](auto const& a, auto const& b) {
+            return std::min(std::abs(a[0] - poles[i][0]), std::abs(a[1] - poles[i][0]))
+                   < std::min(std::abs(b[0] - poles[i][0]), std::abs(b[1] - poles[i][0]));
+        });
+        matched[i] = *nearest;
+        zeros.erase(nearest);
+    }
+
+    iir_sections<Sections> ret{};
+    double const           scale = std::pow(std::abs(zpk.gain), 1. / static_cast<double>(Sections));
+    for (std::size_t s{}; s < std::min(Sections, poles.size()); s++) {
+        auto const& [z1, z2] = matched[s];
+        auto const& [p1, p2] = poles[s];
+        ret[s]               = {1., -(z1 + z2).real(), (z1 * z2).real(), -(p1 + p2).real(), (p1 * p2).real()};
+    }
+    for (std::size_t s{}; s < Sections; s++) {
+        double const factor = (s == 0 && zpk.gain < 0) ? -scale : scale;
+        ret[s].b0 *= factor;
+        ret[s].b1 *= factor;
+        ret[s].b2 *= factor;
+    }
+    return ret;
+}
+
+inline double
+prewarp(double frequency, double sampling)
+{
+    return std::tan(std::numbers::pi * frequency / sampling);
+}
+
+template <std::size_t Sections>
+iir_sections<Sections>
+design_lowpass(iir_zpk const& prototype, double cutoff, double sampling)
+{
+    return to_sections<Sections>(bilinear(to_lowpass(prototype, prewarp(cutoff, sampling))));
+}
+
+template <std::size_t Sections>
+iir_sections<Sections>
+design_highpass(iir_zpk const& prototype, double cutoff, double sampling)
+{
+    return to_sections<Sections>(bilinear(to_highpass(prototype, prewarp(cutoff, sampling))));
+}
+
+template <std::size_t Sections>
+iir_sections<Sections>
+design_bandpass(iir_zpk const& prototype, double low, double high, double sampling)
+{
+    auto const w1 = prewarp(low, sampling);
+    auto const w2 = prewarp(high, sampling);
+    return to_sections<Sections>(bilinear(to_bandpass(prototype, std::sqrt(w1 * w2), w2 - w1)));
+}
+
+}    // namespace detail
+
+/**
+ * Butterworth designs, maximally flat passband, -3 dB at the edges.
+ * Lowpass and highpass cascades have (Order + 1) / 2 sections, bandpass cascades have Order sections.
+ * Frequencies are in the units of the sampling rate, edges are prewarped so they land exactly where asked.
+ */
+template <std::size_t Order>
+struct butterworth {
+    static_assert(Order >= 1, "Filter order should be positive!");
+
+    static iir_sections<(Order + 1) / 2>
+    lowpass(double cutoff, double sampling)
+    {
+        return detail::design_lowpass<(Order + 1) / 2>(detail::butterworth_prototype(Order), cutoff, sampling);
+    }
+
+    static iir_sections<(Order + 1) / 2>
+    highpass(double cutoff, double sampling)
+    {
+        return detail::design_highpass<(Order + 1) / 2>(detail::butterworth_prototype(Order), cutoff, sampling);
+    }
+
+    static iir_sections<Order>
+    bandpass(double low, double high, double sampling)
+    {
+        return detail::design_bandpass<Order>(detail::butterworth_prototype(Order), low, high, sampling);
+    }
+};
+
+/**
+ * Chebyshev type I designs, equiripple passband of ripple dB down to the edges, monotonic stopband
+ */
+template <std::size_t Order>
+struct chebyshev {
+    static_assert(Order >= 1, "Filter order should be positive!");
+
+    static iir_sections<(Order + 1) / 2>
+    lowpass(double cutoff, double sampling, double ripple = 1.)
+    {
+        return detail::design_lowpass<(Order + 1) / 2>(detail::chebyshev_prototype(Order, ripple), cutoff, sampling);
+    }
+
+    static iir_sections<(Order + 1) / 2>
+    highpass(double cutoff, double sampling, double ripple = 1.)
+    {
+        return detail::design_highpass<(Order + 1) / 2>(detail::chebyshev_prototype(Order, ripple), cutoff,
+                                                        sampling);
+    }
+
+    static iir_sections<Order>
+    bandpass(double low, double high, double sampling, double ripple = 1.)
+    {
+        return detail::design_bandpass<Order>(detail::chebyshev_prototype(Order, ripple), low, high, sampling);
+    }
+};
+
+/**
+ * Elliptic (Cauer) designs, equiripple passband of ripple dB and stopband at least attenuation dB down,
+ * the sharpest transition for a given order
+ */
+template <std::size_t Order>
+struct elliptic {
+    static_assert(Order >= 1, "Filter order should be positive!");
+
+    static iir_sections<(Order + 1) / 2>
+    lowpass(double cutoff, double sampling, double ripple = 1., double attenuation = 60.)
+    {
+        return detail::design_lowpass<(Order + 1) / 2>(detail::elliptic_prototype(Order, ripple, attenuation), cutoff,
+                                                       sampling);
+    }
+
+    static iir_sections<(Order + 1) / 2>
+    highpass(double cutoff, double sampling, double ripple = 1., double attenuation = 60.)
+    {
+        return detail::design_highpass<(Order + 1) / 2>(detail::elliptic_prototype(Order, ripple, attenuation),
+                                                        cutoff, sampling);
+    }
+
+    static iir_sections<Order>
+    bandpass(double low, double high, double sampling, double ripple = 1., double attenuation = 60.)
+    {
+        return detail::design_bandpass<Order>(detail::elliptic_prototype(Order, ripple, attenuation), low, high,
+                                              sampling);
+    }
+};
+
+/**
+ * Cascade of second-order sections in transposed direct form II: every section keeps two state values and
+ * costs five multiplies per sample, and the state only ever holds partial outputs, which keeps float cascades
+ * well behaved.
+ */
+template <std::size_t Sections, class Type = double>
+class biquad_cascade {
+    static_assert(Sections >= 1, "Cascade should have sections!");
+
+public:
+    /**
+     * Constructs a cascade from designed sections
+     * @param sections the sections, run in array order
+     */
+    template <class Other>
+    explicit biquad_cascade(std::array<biquad<Other>, Sections> const& sections)
+    {
+        for (std::size_t s{}; s < Sections; s++) {
+            sections_[s] = {static_cast<Type>(sections[s].b0), static_cast<Type>(sections[s].b1),
+                            static_cast<Type>(sections[s].b2), static_cast<Type>(sections[s].a1),
+                            static_cast<Type>(sections[s].a2)};
+        }
+    }
+
+    /**
+     * Applies the filter to a new data point
+     * @param val the new data point
+     * @return the filtered data point
+     */
+    Type
+    value(Type val)
+    {
+        for (std::size_t s{}; s < Sections; s++) {
+            auto const& c = sections_[s];
+            auto&       z = state_[s];
+            Type const  y = c.b0 * val + z[0];
+            z[0]          = c.b1 * val - c.a1 * y + z[1];
+            z[1]          = c.b2 * val - c.a2 * y;
+            val           = y;
+        }
+        return val;
+    }
+
+    /**
+     * Applies the filter to a block of data points, out[n] is what value(in[n]) would return
+     * @param in the new data points
+     * @param out the filtered data points, may be the same as in
+     * @return the number of processed data points, the smaller of both sizes
+     */
+    std::size_t
+    process(std::span<Type const> in, std::span<Type> out)
+    {
+        auto const size = std::min(in.size(), out.size());
+        std::copy_n(in.begin(), size, out.begin());
+        // Section by section over the block, the state and coefficients of a section stay in registers
+        for (std::size_t s{}; s < Sections; s++) {
+            auto const c  = sections_[s];
+            Type       z0 = state_[s][0];
+            Type       z1 = state_[s][1];
+            for (std::size_t n{}; n < size; n++) {
+                Type const x = out[n];
+                Type const y = c.b0 * x + z0;
+                z0           = c.b1 * x - c.a1 * y + z1;
+                z1           = c.b2 * x - c.a2 * y;
+                out[n]       = y;
+            }
+            state_[s] = {z0, z1};
+        }
+        return size;
+    }
+
+    /**
+     * Resets the filter state
+     */
+    void
+    reset()
+    {
+        state_ = {};
+    }
+
+    /**
+     * Returns the sections
+     * @return the sections
+     */
+    std::array<biquad<Type>, Sections>
+    sections() const
+    {
+        return sections_;
+    }
+
+    /**
+     * Evaluates the frequency response
+     * @param frequency the frequency, in the units of the sampling rate
+     * @param sampling the sampling rate
+     * @return H(e^jw)
+     */
+    std::complex<double>
+    response(double frequency, double sampling) const
+    {
+        auto const           z = std::polar(1., -2. * std::numbers::pi * frequency / sampling);
+        std::complex<double> ret{1.};
+        for (auto const& c : sections_) {
+            ret *= (static_cast<double>(c.b0) + z * (static_cast<double>(c.b1) + z * static_cast<double>(c.b2)))
+                   / (1. + z * (static_cast<double>(c.a1) + z * static_cast<double>(c.a2)));
+        }
+        return ret;
+    }
+
+private:
+    std::array<biquad<Type>, Sections>        sections_{};
+    std::array<std::array<Type, 2>, Sections> state_{};
+};
+
+/**
+ * The same biquad cascade applied to Channels independent channels.
+ * The states are stored channel by channel next to each other, so one section update runs as vector
+ * operations across the channels, a block of frames is filtered section by section. Double banks run the
+ * detail::lane_ops vectors of filter_bank, other types a plain loop over one register width of channels.
+ */
+template <std::size_t Sections, std::size_t Channels, class Type = double>
+class biquad_bank {
+    static_assert(Sections >= 1 && Channels >= 1, "Bank should have sections and channels!");
+
+public:
+    /**
+     * Constructs a bank from designed sections
+     * @param sections the sections shared by all channels
+     */
+    template <class Other>
+    explicit biquad_bank(std::array<biquad<Other>, Sections> const& sections)
+    {
+        for (std::size_t s{}; s < Sections; s++) {
+            sections_[s] = {static_cast<Type>(sections[s].b0), static_cast<Type>(sections[s].b1),
+                            static_cast<Type>(sections[s].b2), static_cast<Type>(sections[s].a1),
+                            static_cast<Type>(sections[s].a2)};
+        }
+    }
+
+    /**
+     * Applies the filter to one frame of all channels
+     * @param frame the new data points, one per channel
+     * @param out the filtered data points, one per channel
+     */
+    void
+    value(std::span<Type const, Channels> frame, std::span<Type, Channels> out)
+    {
+        std::copy(frame.begin(), frame.end(), out.begin());
+        filter_frames(out.data(), 1);
+    }
+
+    /**
+     * Applies the filter to a block of frames
+     * @param in the new data points, a whole number of frames, planar blocks hold in.size() / Channels frames
+     * @param out the filtered data points, in the same layout
+     * @param layout the layout of in and out
+     * @return the number of processed frames, the smaller of both sizes divided by Channels
+     */
+    std::size_t
+    process(std::span<Type const> in, std::span<Type> out, frame_layout layout = frame_layout::interleaved)
+    {
+        auto const frames = std::min(in.size(), out.size()) / Channels;
+        if (layout == frame_layout::interleaved) {
+            std::copy_n(in.begin(), frames * Channels, out.begin());
+            filter_frames(out.data(), frames);
+            return frames;
+        }
+        // Planar blocks are transposed through an interleaved buffer
+        auto const in_stride  = in.size() / Channels;
+        auto const out_stride = out.size() / Channels;
+        buffer_.resize(planar_chunk * Channels);
+        for (std::size_t done{}; done < frames; done += planar_chunk) {
+            auto const count = std::min(planar_chunk, frames - done);
+            for (std::size_t c{}; c < Channels; c++) {
+                for (std::size_t f{}; f < count; f++) {
+                    buffer_[f * Channels + c] = in[c * in_stride + done + f];
+                }
+            }
+            filter_frames(buffer_.data(), count);
+            for (std::size_t c{}; c < Channels; c++) {
+                for (std::size_t f{}; f < count; f++) {
+                    out[c * out_stride + done + f] = buffer_[f * Channels + c];
+                }
+            }
+        }
+        return frames;
+    }
+
+    /**
+     * Resets the states of all channels
+     */
+    void
+    reset()
+    {
+        for (auto& item : state_) {
+            item = {};
+        }
+    }
+
+    /**
+     * Returns the sections
+     * @return the sections
+     */
+    std::array<biquad<Type>, Sections>
+    sections() const
+    {
+        return sections_;
+    }
+
+private:
+    using lane_ops = detail::lane_ops;
+
+    static constexpr std::size_t planar_chunk = 64;
+    // Vectors of four double channels per pass: their two states, the five coefficients and the temporaries
+    // fit the 16 AVX registers, and three independent recursions hide most of the mul-add latency
+    static constexpr std::size_t group = 3;
+    // Channels per pass, other types take one 32 byte register of channels per state array
+    static constexpr std::size_t lanes = std::is_same_v<Type, double> ? 4 * group : 32 / sizeof(Type);
+
+    struct section_state {
+        std::array<Type, Channels> z0{};
+        std::array<Type, Channels> z1{};
+    };
+
+    std::array<biquad<Type>, Sections>  sections_{};
+    std::array<section_state, Sections> state_{};
+    std::vector<Type>                   buffer_;
+
+    void
+    filter_frames(Type* data, std::size_t frames)
+    {
+        constexpr std::size_t grouped = Channels / lanes * lanes;
+        for (std::size_t s{}; s < Sections; s++) {
+            if constexpr (std::is_same_v<Type, double>) {
+                constexpr std::size_t vectors = Channels / 4 * 4;
+                for (std::size_t c{}; c < grouped; c += lanes) {
+                    update_group(s, c, data, frames, std::make_index_sequence<group>{});
+                }
+                if constexpr (vectors > grouped) {
+                    update_group(s, grouped, data, frames, std::make_index_sequence<(vectors - grouped) / 4>{});
+                }
+                if constexpr (Channels > vectors) {
+                    update<Channels - vectors>(s, vectors, data, frames);
+                }
+            } else {
+                for (std::size_t c{}; c < grouped; c += lanes) {
+                    update<lanes>(s, c, data, frames);
+                }
+                if constexpr (Channels > grouped) {
+                    update<Channels - grouped>(s, grouped, data, frames);
+                }
+            }
+        }
+    }
+
+    // Consecutive vectors of four channels from first through all frames, the states stay in registers
+    template <std::size_t... Vector>
+    void
+    update_group(std::size_t section, std::size_t first, double* data, std::size_t frames,
+                 std::index_sequence<Vector...>)
+    {
+        auto const&          c  = sections_[section];
+        auto&                z  = state_[section];
+        auto const           b0 = lane_ops::broadcast(c.b0);
+        auto const           b1 = lane_ops::broadcast(c.b1);
+        auto const           b2 = lane_ops::broadcast(c.b2);
+        auto const           a1 = lane_ops::broadcast(-c.a1);
+        auto const           a2 = lane_ops::broadcast(-c.a2);
+        lane_ops::value_type z0[]{lane_ops::load(&z.z0[first + 4 * Vector])...};
+        lane_ops::value_type z1[]{lane_ops::load(&z.z1[first + 4 * Vector])...};
+        for (std::size_t f{}; f < frames; f++) {
+            double*    frame  = data + f * Channels + first;
+            auto const update = [&](std::size_t v) {
+                auto const x = lane_ops::load(frame + 4 * v);
+                auto const y = lane_ops::add(lane_ops::mul(b0, x), z0[v]);
+                z0[v]        = lane_ops::add(lane_ops::add(lane_ops::mul(b1, x), lane_ops::mul(a1, y)), z1[v]);
+                z1[v]        = lane_ops::add(lane_ops::mul(b2, x), lane_ops::mul(a2, y));
+                lane_ops::store(frame + 4 * v, y);
+            };
+            (update(Vector), ...);
+        }
+        (lane_ops::store(&z.z0[first + 4 * Vector], z0[Vector]), ...);
+        (lane_ops::store(&z.z1[first + 4 * Vector], z1[Vector]), ...);
+    }
+
+    // Count channels from first through all frames, a plain loop over local state arrays the compiler may
+    // vectorize
+    template <std::size_t Count>
+    void
+    update(std::size_t section, std::size_t first, Type* data, std::size_t frames)
+    {
+        auto const              c = sections_[section];
+        auto&                   z = state_[section];
+        std::array<Type, Count> z0;
+        std::array<Type, Count> z1;
+        std::copy_n(&z.z0[first], Count, z0.begin());
+        std::copy_n(&z.z1[first], Count, z1.begin());
+        for (std::size_t f{}; f < frames; f++) {
+            Type* frame = data + f * Channels + first;
+            std::array<Type, Count> x;
+            std::copy_n(frame, Count, x.begin());
+            for (std::size_t k{}; k < Count; k++) {
+                Type const y = c.b0 * x[k] + z0[k];
+                z0[k]        = c.b1 * x[k] - c.a1 * y + z1[k];
+                z1[k]        = c.b2 * x[k] - c.a2 * y;
+                x[k]         = y;
+            }
+            std::copy_n(x.begin(), Count, frame);
+        }
+        std::copy_n(z0.begin(), Count, &z.z0[first]);
+        std::copy_n(z1.begin(), Count, &z.z1[first]);
+    }
+};
+
+}    // namespace xitren::math
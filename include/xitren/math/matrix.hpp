@@ -1,19 +1,24 @@
 #pragma once
 
 #include <xitren/math/matrix_strassen.hpp>
+#include <xitren/math/random.hpp>
+#include <xitren/math/semiring.hpp>
 
 #include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
-#include <cstdlib>
 #include <cstring>
-#include <ctime>
 #include <memory>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#if defined(__SSE2__)
+#    include <emmintrin.h>
+#endif
+
 namespace xitren::math {
 
 template <class Type, std::size_t Rows, std::size_t Columns, std::size_t Batch = 0>
@@ -27,23 +32,15 @@ class matrix {
         if (Batch != 0) {
             return Batch;
         }
+        // Largest tile that fits both dimensions and keeps three tiles (two operands and the result) in cache
         std::array<std::size_t, 7> sizes{{128, 64, 32, 16, 8, 4, 2}};
-
-        std::size_t max_row{2};
-        for (auto& size : sizes) {
-            if ((Rows / size) != 0) {
-                max_row = size;
-            }
-            break;
-        }
-        std::size_t max_col{2};
         for (auto& size : sizes) {
-            if ((Columns / size) != 0) {
-                max_col = size;
+            if ((size <= XITREN_MATH_BATCH) && ((Rows / size) != 0) && ((Columns / size) != 0)
+                && (3 * size * size * sizeof(Type) <= XITREN_MATH_CACHE_SIZE)) {
+                return size;
             }
-            break;
         }
-        return std::min(max_row, max_col);
+        return 2;
     }
 
 public:
@@ -68,31 +65,86 @@ public:
     matrix() = default;
     matrix(init_type const& data)
     {
-        // ToDo: Rewrite this to init version
-        for (std::size_t row{}; row < Rows; row++) {
-            for (std::size_t column{}; column < Columns; column++) {
-                get(row, column) = data[row * Columns + column];
-            }
-        }
+        for_each([&data](std::size_t row, std::size_t column, Type& item) { item = data[row * Columns + column]; });
     }
 
     Type&
     get(std::size_t row, std::size_t column)
     {
         if ((row < batch_rows_end) && (column < batch_columns_end)) {
-            auto const i   = row / batch_value;
-            auto const j   = column / batch_value;
-            auto&      val = batched_section[i][j].get(row % batch_value, column % batch_value);
-            return val;
-        } else {
-            if ((row < batch_rows_end) && (column >= batch_columns_end)) {
-                return rest_columns_section[row][column - batch_columns_end];
-            } else {
-                auto xr = row - batch_rows_end;
-                auto xc = column - batch_columns_end;
-                return rest_rows_section[row - batch_rows_end][column];
-            }
+            auto& batch = batched_section[row / batch_value][column / batch_value];
+            return batch.get(row % batch_value, column % batch_value);
+        }
+        if (row < batch_rows_end) {
+            return rest_columns_section[row][column - batch_columns_end];
         }
+        return rest_rows_section[row - batch_rows_end][column];
+    }
+
+    Type const&
+    get(std::size_t row, std::size_t column) const
+    {
+        return const_cast<matrix*>(this)->get(row, column);
+    }
+
+    /**
+     * Visits every element in storage order, so the pass streams memory sequentially
+     * @param func callable taking (row, column, element)
+     */
+    template <class Func>
+    void
+    for_each(Func func)
+    {
+        for_each_impl(*this, func);
+    }
+
+    template <class Func>
+    void
+    for_each(Func func) const
+    {
+        for_each_impl(*this, func);
+    }
+
+    /**
+     * Serializes the matrix in row-major order with one sequential pass over the storage
+     * @return the row-major elements
+     */
+    init_type
+    row_major() const
+    {
+        init_type ret;
+        for_each([&ret](std::size_t row, std::size_t column, Type const& item) {
+            ret[row * Columns + column] = item;
+        });
+        return ret;
+    }
+
+    /**
+     * Transposes the matrix: ret = (*this)^T
+     * @param ret the result
+     */
+    void
+    transpose(matrix<Type, Columns, Rows, Batch>& ret) const
+    {
+        for_each([&ret](std::size_t row, std::size_t column, Type const& item) { ret.get(column, row) = item; });
+    }
+
+    /**
+     * Returns the batch tile at the given tile position of the batch zone
+     * @param row the tile row, less than batch_rows
+     * @param column the tile column, less than batch_columns
+     * @return the tile
+     */
+    batch_type&
+    batch(std::size_t row, std::size_t column)
+    {
+        return batched_section[row][column];
+    }
+
+    batch_type const&
+    batch(std::size_t row, std::size_t column) const
+    {
+        return batched_section[row][column];
     }
 
     template <class T, std::size_t R, std::size_t C, std::size_t B>
@@ -111,94 +163,368 @@ public:
     //                           |  R R   R R  R |                             |  R R  R |
     template <std::size_t ColumnsOther>
     void
-    mult(matrix<Type, Columns, ColumnsOther, Batch>& other, matrix<Type, Rows, ColumnsOther, Batch>& ret)
+    mult(matrix<Type, Columns, ColumnsOther, Batch> const& other, matrix<Type, Rows, ColumnsOther, Batch>& ret) const
+    {
+        gemm(Type{1}, other, Type{0}, ret);
+    }
+
+    /**
+     * Product in the given semiring, e.g. mult<min_plus<double>>(distances, paths) for shortest paths.
+     * Runs the tiled classical kernels with the GEMM blocking and threading; Strassen is used only for semirings
+     * with subtraction.
+     * @param other right hand operand
+     * @param ret the result
+     */
+    template <class Semiring, std::size_t ColumnsOther>
+    void
+    mult(matrix<Type, Columns, ColumnsOther, Batch> const& other, matrix<Type, Rows, ColumnsOther, Batch>& ret) const
+    {
+        static_assert(batch_value == other.batch_value);
+        if constexpr (Semiring::has_subtraction) {
+            gemm(Semiring::one(), other, Semiring::zero(), ret);
+        } else {
+            semiring_mult<Semiring>(other, ret);
+        }
+    }
+
+    /**
+     * Fused product with accumulation: ret = alpha * (*this) * other + beta * ret.
+     * Every zone of ret is read and written once; with beta == 0 ret is not read at all.
+     * @param alpha scale of the product
+     * @param other right hand operand
+     * @param beta scale of the previous ret contents
+     * @param ret the accumulator
+     */
+    template <std::size_t ColumnsOther>
+    void
+    gemm(Type alpha, matrix<Type, Columns, ColumnsOther, Batch> const& other, Type beta,
+         matrix<Type, Rows, ColumnsOther, Batch>& ret) const
     {
-        // ToDo: get back to const
         static_assert(batch_value == other.batch_value);
         using ret_type = matrix<Type, Rows, ColumnsOther, batch_value>;
-        // Calculate batch zone
-        for (std::size_t i = 0; i < ret_type::batch_rows; i++) {
+        // Calculate batch zone, bands of tile rows run on the worker threads
+        parallel_for(ret_type::batch_rows, tile_rows_grain(ColumnsOther), [&](std::size_t begin, std::size_t end) {
+            gemm_tiles(alpha, other, beta, ret, begin, end);
+        });
+        gemm_rest(alpha, other, beta, ret);
+    }
+
+    /**
+     * Tile zone part of gemm: computes the tile rows [begin, end) of ret, the unit of work of the parallel drivers
+     * @param alpha scale of the product
+     * @param other right hand operand
+     * @param beta scale of the previous ret contents
+     * @param ret the accumulator
+     * @param begin the first tile row
+     * @param end the tile row past the last one
+     */
+    template <std::size_t ColumnsOther>
+    void
+    gemm_tiles(Type alpha, matrix<Type, Columns, ColumnsOther, Batch> const& other, Type beta,
+               matrix<Type, Rows, ColumnsOther, Batch>& ret, std::size_t begin, std::size_t end) const
+    {
+        using ret_type = matrix<Type, Rows, ColumnsOther, batch_value>;
+        std::vector<Type> rest_tile(rest_columns != 0 ? batch_value * batch_value : 0);
+        for (std::size_t i = begin; i < end; i++) {
             for (std::size_t j = 0; j < ret_type::batch_columns; j++) {
-                ret.batched_section[i][j].clear();
+                batch_type acc{};
                 for (std::size_t k = 0; k < batch_columns; k++) {
-                    ret.batched_section[i][j]
-                        = ret.batched_section[i][j] + batched_section[i][k] * other.batched_section[k][j];
+                    acc = acc + batched_section[i][k] * other.batched_section[k][j];
                 }
-                batch_type rest{};
-                auto const ix = i * batch_value;
-                auto const jy = j * batch_value;
-                for (std::size_t x = 0; x < batch_value; x++) {
-                    for (std::size_t y = 0; y < batch_value; y++) {
-                        auto& rest_item = rest.get(x, y);
-                        rest_item       = 0;
-                        for (std::size_t z = 0; z < rest_rows; z++) {
-                            rest_item += rest_columns_section[x + ix][z] * other.rest_rows_section[z][y + jy];
-                        }
+                if constexpr (rest_columns != 0) {
+                    // Inner dimension rest: rest columns strip of *this by rest rows strip of other
+                    std::fill(rest_tile.begin(), rest_tile.end(), Type{});
+                    inner_rest(other, i, j, rest_tile.data());
+                    auto* ptr = acc.data();
+                    for (std::size_t k = 0; k < acc.size(); k++) {
+                        auto const [x, y] = morton_position(k);
+                        ptr[k] += rest_tile[x * batch_value + y];
                     }
                 }
-                ret.batched_section[i][j] = ret.batched_section[i][j] + rest;
+                blend(acc.size(), alpha, acc.data(), beta, ret.batched_section[i][j].data());
             }
         }
-        // Calculate rest columns zone
-        for (std::size_t i = 0; i < ret.rest_columns_section.size(); i++) {
-            for (std::size_t j = 0; j < ret_type::rest_columns; j++) {
-                ret.rest_columns_section[i][j] = 0;
-                auto const m_col               = j + ret_type::batch_columns_end;
-                for (std::size_t k = 0; k < Columns; k++) {
-                    ret.rest_columns_section[i][j] += get(i, k) * other.get(k, m_col);
-                }
-            }
+    }
+
+    /**
+     * Rest zone part of gemm: computes the rest columns and the rest rows of ret
+     * @param alpha scale of the product
+     * @param other right hand operand
+     * @param beta scale of the previous ret contents
+     * @param ret the accumulator
+     */
+    template <std::size_t ColumnsOther>
+    void
+    gemm_rest(Type alpha, matrix<Type, Columns, ColumnsOther, Batch> const& other, Type beta,
+              matrix<Type, Rows, ColumnsOther, Batch>& ret) const
+    {
+        using ret_type = matrix<Type, Rows, ColumnsOther, batch_value>;
+        // Calculate rest columns zone: rows of *this by the gathered rest columns of other
+        if constexpr (ret_type::rest_columns != 0) {
+            rest_columns_product(other, [&](std::size_t i, std::size_t j, Type sum) {
+                blend(1, alpha, &sum, beta, &ret.rest_columns_section[i][j]);
+            });
         }
-        // Calculate rest rows zone
-        for (std::size_t i = 0; i < rest_rows; i++) {
-            for (std::size_t j = 0; j < Columns; j++) {
-                ret.rest_rows_section[i][j] = 0;
-                auto const m_row            = i + batch_rows_end;
-                for (std::size_t k = 0; k < Columns; k++) {
-                    ret.rest_rows_section[i][j] += get(m_row, k) * other.get(k, j);
-                }
-            }
+        // Calculate rest rows zone: rest rows of *this accumulate the gathered rows of other
+        if constexpr (rest_rows != 0) {
+            std::vector<Type> acc(rest_rows * ColumnsOther);
+            rest_rows_product(other, acc.data());
+            blend(acc.size(), alpha, acc.data(), beta, ret.rest_rows_data());
         }
     }
 
+    /**
+     * Multiplies through copies rounded up to whole batches, so only the batch kernels run
+     * @param other right hand operand
+     * @param ret the result
+     */
+    template <std::size_t ColumnsOther>
+    void
+    mult_padded(matrix<Type, Columns, ColumnsOther, Batch> const& other,
+                matrix<Type, Rows, ColumnsOther, Batch>&       ret) const
+    {
+        gemm_padded(Type{1}, other, Type{0}, ret);
+    }
+
+    /**
+     * Fused product through copies rounded up to whole batches: ret = alpha * (*this) * other + beta * ret.
+     * Worth it when the rest zones are a large share of the work, e.g. a single extra row or column.
+     * @param alpha scale of the product
+     * @param other right hand operand
+     * @param beta scale of the previous ret contents
+     * @param ret the accumulator
+     */
+    template <std::size_t ColumnsOther>
+    void
+    gemm_padded(Type alpha, matrix<Type, Columns, ColumnsOther, Batch> const& other, Type beta,
+                matrix<Type, Rows, ColumnsOther, Batch>& ret) const
+    {
+        static_assert(batch_value == other.batch_value);
+        using padded_type       = matrix<Type, padded(Rows), padded(Columns), batch_value>;
+        using padded_other_type = matrix<Type, padded(Columns), padded(ColumnsOther), batch_value>;
+        using padded_ret_type   = matrix<Type, padded(Rows), padded(ColumnsOther), batch_value>;
+
+        auto padded_this  = std::make_unique<padded_type>();
+        auto padded_other = std::make_unique<padded_other_type>();
+        auto padded_ret   = std::make_unique<padded_ret_type>();
+        for_each([&](std::size_t row, std::size_t column, Type const& item) { padded_this->get(row, column) = item; });
+        other.for_each(
+            [&](std::size_t row, std::size_t column, Type const& item) { padded_other->get(row, column) = item; });
+        if (beta != Type{0}) {
+            ret.for_each(
+                [&](std::size_t row, std::size_t column, Type const& item) { padded_ret->get(row, column) = item; });
+        }
+        padded_this->gemm(alpha, *padded_other, beta, *padded_ret);
+        ret.for_each([&](std::size_t row, std::size_t column, Type& item) { item = padded_ret->get(row, column); });
+    }
+
     void
     add(matrix const& other, matrix& ret) const
     {
         static_assert(batch_value == other.batch_value);
-        for (std::size_t i = 0; i < batch_rows; i++) {
-            for (std::size_t j = 0; j < batch_columns; j++) {
-                ret.batched_section[i][j] = batched_section[i][j] + other.batched_section[i][j];
+        sweep([](Type a, Type b) { return a + b; }, ret, *this, other);
+    }
+
+    void
+    sub(matrix const& other, matrix& ret) const
+    {
+        static_assert(batch_value == other.batch_value);
+        sweep([](Type a, Type b) { return a - b; }, ret, *this, other);
+    }
+
+    /**
+     * Scales the matrix: ret = alpha * (*this)
+     * @param alpha the scale
+     * @param ret the result, may be *this
+     */
+    void
+    scale(Type alpha, matrix& ret) const
+    {
+        sweep([alpha](Type a) { return alpha * a; }, ret, *this);
+    }
+
+    /**
+     * Scaled addition in one pass: ret = alpha * (*this) + other
+     * @param alpha the scale of *this
+     * @param other the addend
+     * @param ret the result, may be other for the in-place BLAS form
+     */
+    void
+    axpy(Type alpha, matrix const& other, matrix& ret) const
+    {
+        sweep([alpha](Type a, Type b) { return alpha * a + b; }, ret, *this, other);
+    }
+
+    /**
+     * Element-wise (Hadamard) product: ret = (*this) o other
+     * @param other the second factor
+     * @param ret the result
+     */
+    void
+    hadamard(matrix const& other, matrix& ret) const
+    {
+        sweep([](Type a, Type b) { return a * b; }, ret, *this, other);
+    }
+
+    /**
+     * Element-wise fused multiply-add in one pass: ret = (*this) o other + addend
+     * @param other the second factor
+     * @param addend the addend
+     * @param ret the result, may alias any operand
+     */
+    void
+    fma(matrix const& other, matrix const& addend, matrix& ret) const
+    {
+        sweep([](Type a, Type b, Type c) { return a * b + c; }, ret, *this, other, addend);
+    }
+
+    /**
+     * Outer product: ret = x * y^T, written tile by tile into the tiled storage
+     * @param x the column vector
+     * @param y the row vector
+     * @param ret the result
+     */
+    static void
+    outer(std::array<Type, Rows> const& x, std::array<Type, Columns> const& y, matrix& ret)
+    {
+        auto const columns = expand_columns(y);
+        parallel_for(batch_rows, fill_grain(), [&](std::size_t begin, std::size_t end) {
+            std::vector<Type> rows(batch_value * batch_value);
+            std::vector<Type> tile(batch_value * batch_value);
+            for (std::size_t i{begin}; i < end; i++) {
+                expand_row(x.data() + i * batch_value, rows.data());
+                for (std::size_t j{}; j < batch_columns; j++) {
+                    Type const* column = &columns[j * batch_value * batch_value];
+                    for (std::size_t k{}; k < batch_value * batch_value; k++) {
+                        tile[k] = rows[k] * column[k];
+                    }
+                    store_tile(tile.data(), ret.batched_section[i][j].data());
+                }
+            }
+            store_fence();
+        });
+        for (std::size_t i{}; i < batch_rows_end; i++) {
+            for (std::size_t j{}; j < rest_columns; j++) {
+                ret.rest_columns_section[i][j] = x[i] * y[batch_columns_end + j];
+            }
+        }
+        for (std::size_t i{}; i < rest_rows; i++) {
+            for (std::size_t j{}; j < Columns; j++) {
+                ret.rest_rows_section[i][j] = x[batch_rows_end + i] * y[j];
             }
         }
-        for (std::size_t i = 0; i < rest_columns_section.size(); i++) {
-            for (std::size_t j = 0; j < rest_columns; j++) {
-                ret.rest_columns_section[i][j] = rest_columns_section[i][j] + other.rest_columns_section[i][j];
+    }
+
+    /**
+     * Rank-1 update (BLAS ger): ret = (*this) + alpha * x * y^T in one pass over the tiled storage
+     * @param alpha the scale of the update
+     * @param x the column vector
+     * @param y the row vector
+     * @param ret the result, may be *this for the in-place BLAS form
+     */
+    void
+    ger(Type alpha, std::array<Type, Rows> const& x, std::array<Type, Columns> const& y, matrix& ret) const
+    {
+        auto const columns = expand_columns(y);
+        parallel_for(batch_rows, fill_grain(), [&](std::size_t begin, std::size_t end) {
+            std::vector<Type> rows(batch_value * batch_value);
+            for (std::size_t i{begin}; i < end; i++) {
+                expand_row(x.data() + i * batch_value, rows.data());
+                for (auto& item : rows) {
+                    item *= alpha;
+                }
+                for (std::size_t j{}; j < batch_columns; j++) {
+                    Type const* column = &columns[j * batch_value * batch_value];
+                    Type const* in     = batched_section[i][j].data();
+                    Type*       out    = ret.batched_section[i][j].data();
+                    for (std::size_t k{}; k < batch_value * batch_value; k++) {
+                        out[k] = in[k] + rows[k] * column[k];
+                    }
+                }
+            }
+        });
+        for (std::size_t i{}; i < batch_rows_end; i++) {
+            for (std::size_t j{}; j < rest_columns; j++) {
+                ret.rest_columns_section[i][j] = rest_columns_section[i][j] + alpha * x[i] * y[batch_columns_end + j];
             }
         }
-        for (std::size_t i = 0; i < rest_rows; i++) {
-            for (std::size_t j = 0; j < Columns; j++) {
-                ret.rest_rows_section[i][j] = rest_rows_section[i][j] + other.rest_rows_section[i][j];
+        for (std::size_t i{}; i < rest_rows; i++) {
+            auto const factor = alpha * x[batch_rows_end + i];
+            for (std::size_t j{}; j < Columns; j++) {
+                ret.rest_rows_section[i][j] = rest_rows_section[i][j] + factor * y[j];
             }
         }
     }
 
+    /**
+     * Kronecker product: ret = (*this) (x) other, element (i * RowsOther + k, j * ColumnsOther + l) is
+     * this(i, j) * other(k, l). Every band of tile rows is built as row-major rows, each one a vectorized scaled
+     * copy of the rows of other, and then gathered into Z-order tiles stored with streaming stores for large outputs.
+     * @param other the right factor
+     * @param ret the result
+     */
+    template <std::size_t RowsOther, std::size_t ColumnsOther>
     void
-    sub(matrix const& other, matrix& ret) const
+    kron(matrix<Type, RowsOther, ColumnsOther, Batch> const& other,
+         matrix<Type, Rows * RowsOther, Columns * ColumnsOther, Batch>& ret) const
     {
-        static_assert(batch_value == other.batch_value);
-        for (std::size_t i = 0; i < batch_rows; i++) {
-            for (std::size_t j = 0; j < batch_columns; j++) {
-                ret.batched_section[i][j] = batched_section[i][j] - other.batched_section[i][j];
+        using ret_type       = matrix<Type, Rows * RowsOther, Columns * ColumnsOther, Batch>;
+        constexpr auto size  = ret_type::batch_value;
+        constexpr auto area  = size * size;
+        constexpr auto width = Columns * ColumnsOther;
+        std::vector<Type> left(Rows * Columns);
+        std::vector<Type> right(RowsOther * ColumnsOther);
+        for_each([&left](std::size_t row, std::size_t column, Type const& item) {
+            left[row * Columns + column] = item;
+        });
+        other.for_each([&right](std::size_t row, std::size_t column, Type const& item) {
+            right[row * ColumnsOther + column] = item;
+        });
+        auto const kron_row = [&](std::size_t row, Type* out) {
+            Type const* factors = &left[(row / RowsOther) * Columns];
+            Type const* line    = &right[(row % RowsOther) * ColumnsOther];
+            for (std::size_t j{}; j < Columns; j++) {
+                for (std::size_t l{}; l < ColumnsOther; l++) {
+                    out[j * ColumnsOther + l] = factors[j] * line[l];
+                }
             }
+        };
+        // Position in a band of row-major rows of every Z-order pair of the first tile, a pair is two adjacent columns
+        std::vector<std::uint32_t> gather(area / 2);
+        for (std::size_t k{}; k < area / 2; k++) {
+            auto const [row, column] = morton_position(2 * k);
+            gather[k]                = static_cast<std::uint32_t>(row * width + column);
         }
-        for (std::size_t i = 0; i < rest_columns_section.size(); i++) {
-            for (std::size_t j = 0; j < rest_columns; j++) {
-                ret.rest_columns_section[i][j] = rest_columns_section[i][j] - other.rest_columns_section[i][j];
+        parallel_for(ret_type::batch_rows, ret_type::fill_grain(), [&](std::size_t begin, std::size_t end) {
+            std::vector<Type> band(size * width);
+            std::vector<Type> tile(area);
+            for (std::size_t i{begin}; i < end; i++) {
+                for (std::size_t r{}; r < size; r++) {
+                    kron_row(i * size + r, &band[r * width]);
+                }
+                for (std::size_t j{}; j < ret_type::batch_columns; j++) {
+                    Type const* origin = &band[j * size];
+                    for (std::size_t k{}; k < area / 2; k++) {
+                        tile[2 * k]     = origin[gather[k]];
+                        tile[2 * k + 1] = origin[gather[k] + 1];
+                    }
+                    ret_type::store_tile(tile.data(), ret.batched_section[i][j].data());
+                }
+            }
+            ret_type::store_fence();
+        });
+        auto const value = [&](std::size_t row, std::size_t column) {
+            return left[(row / RowsOther) * Columns + column / ColumnsOther]
+                   * right[(row % RowsOther) * ColumnsOther + column % ColumnsOther];
+        };
+        for (std::size_t i{}; i < ret_type::batch_rows_end; i++) {
+            for (std::size_t j{}; j < ret_type::rest_columns; j++) {
+                ret.rest_columns_section[i][j] = value(i, ret_type::batch_columns_end + j);
             }
         }
-        for (std::size_t i = 0; i < rest_rows; i++) {
-            for (std::size_t j = 0; j < Columns; j++) {
-                ret.rest_rows_section[i][j] = rest_rows_section[i][j] - other.rest_rows_section[i][j];
+        for (std::size_t i{}; i < ret_type::rest_rows; i++) {
+            for (std::size_t j{}; j < width; j++) {
+                ret.rest_rows_section[i][j] = value(ret_type::batch_rows_end + i, j);
             }
         }
     }
@@ -206,20 +532,376 @@ public:
     static matrix
     get_rand_matrix()
     {
-        matrix ret{};
-        std::srand(std::time({}));    // use current time as seed for random generator
-        for (std::size_t i = 0; i < Rows; i++) {
-            for (std::size_t j = 0; j < Columns; j++) {
-                ret.get(i, j) = static_cast<Type>(std::rand());
+        return get_rand_matrix(counter_random::seed());
+    }
+
+    /**
+     * Creates a reproducible random matrix, element (row, column) is the position row * Columns + column
+     * of the counter_random stream whatever the batch layout is
+     * @param seed the stream seed
+     * @return the random matrix
+     */
+    static matrix
+    get_rand_matrix(std::uint64_t seed)
+    {
+        matrix     ret{};
+        auto const tiles = batch_rows * batch_columns;
+        auto const grain = std::max<std::size_t>(1, counter_random::grain / (batch_value * batch_value));
+        parallel_for(tiles, grain, [&ret, seed](std::size_t begin, std::size_t end) {
+            for (std::size_t tile{begin}; tile < end; tile++) {
+                auto const i   = (tile / batch_columns) * batch_value;
+                auto const j   = (tile % batch_columns) * batch_value;
+                auto*      ptr = ret.batched_section[tile / batch_columns][tile % batch_columns].data();
+                for (std::size_t k{}; k < batch_value * batch_value; k++) {
+                    auto const [row, column] = morton_position(k);
+                    ptr[k] = counter_random::value<Type>(seed, (i + row) * Columns + j + column);
+                }
+            }
+        });
+        for (std::size_t i{}; i < batch_rows_end; i++) {
+            for (std::size_t j{}; j < rest_columns; j++) {
+                ret.rest_columns_section[i][j]
+                    = counter_random::value<Type>(seed, i * Columns + batch_columns_end + j);
             }
         }
+        counter_random::fill(ret.rest_rows_data(), rest_rows_size, seed, batch_rows_end * Columns);
         return ret;
     }
 
 private:
+    static_assert(sizeof(batch_type) == sizeof(Type) * batch_value * batch_value, "Batch tiles should be dense!");
+
+    static constexpr std::size_t batched_size      = batch_rows * batch_columns * batch_value * batch_value;
+    static constexpr std::size_t rest_columns_size = batch_rows_end * rest_columns;
+    static constexpr std::size_t rest_rows_size    = rest_rows * Columns;
+
     data_type         batched_section;
     rest_columns_type rest_columns_section;
     rest_rows_type    rest_rows_section;
+
+    // Zones are dense arrays of Type, so element-wise passes run over them as flat spans
+    Type*
+    batched_data()
+    {
+        return reinterpret_cast<Type*>(batched_section.data());
+    }
+
+    Type const*
+    batched_data() const
+    {
+        return reinterpret_cast<Type const*>(batched_section.data());
+    }
+
+    Type*
+    rest_columns_data()
+    {
+        return reinterpret_cast<Type*>(rest_columns_section.data());
+    }
+
+    Type const*
+    rest_columns_data() const
+    {
+        return reinterpret_cast<Type const*>(rest_columns_section.data());
+    }
+
+    Type*
+    rest_rows_data()
+    {
+        return reinterpret_cast<Type*>(rest_rows_section.data());
+    }
+
+    Type const*
+    rest_rows_data() const
+    {
+        return reinterpret_cast<Type const*>(rest_rows_section.data());
+    }
+
+    static constexpr std::size_t
+    padded(std::size_t size)
+    {
+        return (size + batch_value - 1) / batch_value * batch_value;
+    }
+
+    // Tile rows per worker thread, so that a band holds about a million multiply-adds
+    static constexpr std::size_t
+    tile_rows_grain(std::size_t columns_other)
+    {
+        return std::max<std::size_t>(1, (std::size_t{1} << 20) / (batch_value * Columns * columns_other));
+    }
+
+    // Adds the inner dimension rest of tile (i, j) into a row-major batch_value x batch_value tile
+    template <class Semiring = plus_times<Type>, std::size_t ColumnsOther>
+    void
+    inner_rest(matrix<Type, Columns, ColumnsOther, Batch> const& other, std::size_t i, std::size_t j,
+               Type* tile) const
+    {
+        auto const ix = i * batch_value;
+        auto const jy = j * batch_value;
+        for (std::size_t x = 0; x < batch_value; x++) {
+            for (std::size_t z = 0; z < rest_columns; z++) {
+                axpy_row<Semiring>(batch_value, rest_columns_section[ix + x][z], &other.rest_rows_section[z][jy],
+                                   &tile[x * batch_value]);
+            }
+        }
+    }
+
+    // Rows of the tile zone by the gathered rest columns of other, func(row, column, sum) takes every sum
+    template <class Semiring = plus_times<Type>, std::size_t ColumnsOther, class Func>
+    void
+    rest_columns_product(matrix<Type, Columns, ColumnsOther, Batch> const& other, Func func) const
+    {
+        using ret_type = matrix<Type, Rows, ColumnsOther, batch_value>;
+        std::vector<Type> columns(ret_type::rest_columns * Columns);
+        std::vector<Type> row(Columns);
+        for (std::size_t j = 0; j < ret_type::rest_columns; j++) {
+            other.copy_column(j + ret_type::batch_columns_end, &columns[j * Columns]);
+        }
+        for (std::size_t i = 0; i < batch_rows_end; i++) {
+            copy_row(i, row.data());
+            for (std::size_t j = 0; j < ret_type::rest_columns; j++) {
+                func(i, j, dot<Semiring>(Columns, row.data(), &columns[j * Columns]));
+            }
+        }
+    }
+
+    // Rest rows of *this accumulate the gathered rows of other into rest_rows x ColumnsOther row-major acc
+    template <class Semiring = plus_times<Type>, std::size_t ColumnsOther>
+    void
+    rest_rows_product(matrix<Type, Columns, ColumnsOther, Batch> const& other, Type* acc) const
+    {
+        std::vector<Type> row(ColumnsOther);
+        for (std::size_t k = 0; k < Columns; k++) {
+            other.copy_row(k, row.data());
+            for (std::size_t i = 0; i < rest_rows; i++) {
+                axpy_row<Semiring>(ColumnsOther, rest_rows_section[i][k], row.data(), &acc[i * ColumnsOther]);
+            }
+        }
+    }
+
+    // Zone by zone product with the semiring classical kernels, tiles accumulate in row-major buffers
+    template <class Semiring, std::size_t ColumnsOther>
+    void
+    semiring_mult(matrix<Type, Columns, ColumnsOther, Batch> const& other,
+                  matrix<Type, Rows, ColumnsOther, Batch>&       ret) const
+    {
+        using ret_type          = matrix<Type, Rows, ColumnsOther, batch_value>;
+        constexpr auto tile_size = batch_value * batch_value;
+        auto const     kernel_rows = tuning::current().kernel_rows;
+        parallel_for(ret_type::batch_rows, tile_rows_grain(ColumnsOther), [&](std::size_t begin, std::size_t end) {
+            std::vector<Type> buffer(3 * tile_size);
+            Type*             a = buffer.data();
+            Type*             b = a + tile_size;
+            Type*             c = b + tile_size;
+            for (std::size_t i = begin; i < end; i++) {
+                for (std::size_t j = 0; j < ret_type::batch_columns; j++) {
+                    std::fill(c, c + tile_size, Semiring::zero());
+                    for (std::size_t k = 0; k < batch_columns; k++) {
+                        batched_section[i][k].to_row_major(a);
+                        other.batched_section[k][j].to_row_major(b);
+                        classic_mult_add<Type, Semiring>(batch_value, a, b, c, kernel_rows);
+                    }
+                    if constexpr (rest_columns != 0) {
+                        inner_rest<Semiring>(other, i, j, c);
+                    }
+                    ret.batched_section[i][j].from_row_major(c);
+                }
+            }
+        });
+        if constexpr (ret_type::rest_columns != 0) {
+            rest_columns_product<Semiring>(
+                other, [&](std::size_t i, std::size_t j, Type sum) { ret.rest_columns_section[i][j] = sum; });
+        }
+        if constexpr (rest_rows != 0) {
+            std::fill_n(ret.rest_rows_data(), rest_rows * ColumnsOther, Semiring::zero());
+            rest_rows_product<Semiring>(other, ret.rest_rows_data());
+        }
+    }
+
+    // Gathers a logical row into a contiguous buffer of Columns elements
+    void
+    copy_row(std::size_t row, Type* out) const
+    {
+        if constexpr (rest_rows != 0) {
+            if (row >= batch_rows_end) {
+                std::copy_n(rest_rows_data() + (row - batch_rows_end) * Columns, Columns, out);
+                return;
+            }
+        }
+        auto const base = morton_index(row % batch_value, 0);
+        for (std::size_t j{}; j < batch_columns; j++) {
+            auto const* ptr = batched_section[row / batch_value][j].data();
+            for (std::size_t column{}; column < batch_value; column++) {
+                *out++ = ptr[base | morton_index(0, column)];
+            }
+        }
+        std::copy_n(rest_columns_section[row].data(), rest_columns, out);
+    }
+
+    // Gathers a logical column into a contiguous buffer of Rows elements
+    void
+    copy_column(std::size_t column, Type* out) const
+    {
+        for (std::size_t row{}; row < Rows; row++) {
+            out[row] = get(row, column);
+        }
+    }
+
+    // Dot product with independent partial sums, so the loop vectorizes without reassociation
+    template <class Semiring = plus_times<Type>>
+    static Type
+    dot(std::size_t size, Type const* a, Type const* b)
+    {
+        using S = Semiring;
+        std::array<Type, 4> sum{S::zero(), S::zero(), S::zero(), S::zero()};
+        std::size_t const   blocks = size - size % 4;
+        std::size_t         i{};
+        for (; i < blocks; i += 4) {
+            sum[0] = S::add(sum[0], S::mul(a[i], b[i]));
+            sum[1] = S::add(sum[1], S::mul(a[i + 1], b[i + 1]));
+            sum[2] = S::add(sum[2], S::mul(a[i + 2], b[i + 2]));
+            sum[3] = S::add(sum[3], S::mul(a[i + 3], b[i + 3]));
+        }
+        for (; i < size; i++) {
+            sum[0] = S::add(sum[0], S::mul(a[i], b[i]));
+        }
+        return S::add(S::add(sum[0], sum[1]), S::add(sum[2], sum[3]));
+    }
+
+    // y = y + alpha * x
+    template <class Semiring = plus_times<Type>>
+    static void
+    axpy_row(std::size_t size, Type alpha, Type const* x, Type* y)
+    {
+        for (std::size_t i{}; i < size; i++) {
+            y[i] = Semiring::add(y[i], Semiring::mul(alpha, x[i]));
+        }
+    }
+
+    template <class Self, class Func>
+    static void
+    for_each_impl(Self& self, Func& func)
+    {
+        for (std::size_t i{}; i < batch_rows; i++) {
+            for (std::size_t j{}; j < batch_columns; j++) {
+                auto* ptr = self.batched_section[i][j].data();
+                for (std::size_t k{}; k < batch_value * batch_value; k++) {
+                    auto const [row, column] = morton_position(k);
+                    func(i * batch_value + row, j * batch_value + column, ptr[k]);
+                }
+            }
+        }
+        for (std::size_t i{}; i < batch_rows_end; i++) {
+            for (std::size_t j{}; j < rest_columns; j++) {
+                func(i, batch_columns_end + j, self.rest_columns_section[i][j]);
+            }
+        }
+        for (std::size_t i{}; i < rest_rows; i++) {
+            for (std::size_t j{}; j < Columns; j++) {
+                func(batch_rows_end + i, j, self.rest_rows_section[i][j]);
+            }
+        }
+    }
+
+    template <class Func, class... Others>
+    static void
+    sweep(Func func, matrix& ret, Others const&... others)
+    {
+        sweep_zone(batched_size, func, ret.batched_data(), others.batched_data()...);
+        sweep_zone(rest_columns_size, func, ret.rest_columns_data(), others.rest_columns_data()...);
+        sweep_zone(rest_rows_size, func, ret.rest_rows_data(), others.rest_rows_data()...);
+    }
+
+    template <class Func, class... Inputs>
+    static void
+    sweep_zone(std::size_t size, Func& func, Type* out, Inputs const*... in)
+    {
+        for (std::size_t i{}; i < size; i++) {
+            out[i] = func(in[i]...);
+        }
+    }
+
+    // Write-only kernels stream their tiles past the caches once the output is too large to be reused from them
+    static constexpr bool stream_stores = sizeof(data_type) >= XITREN_MATH_STREAM_SIZE;
+
+    // Tile rows per worker thread of the write-only kernels, about a million elements
+    static constexpr std::size_t
+    fill_grain()
+    {
+        return std::max<std::size_t>(1, (std::size_t{1} << 20) / (batch_value * Columns));
+    }
+
+    // Z-order expansion of the rows of a tile: out[k] = x[row of position k]
+    static void
+    expand_row(Type const* x, Type* out)
+    {
+        for (std::size_t k{}; k < batch_value * batch_value; k++) {
+            out[k] = x[morton_compact(k >> 1)];
+        }
+    }
+
+    // Z-order expansion of the columns of every tile column: y[column of position k] for tile column j at j * area
+    static std::vector<Type>
+    expand_columns(std::array<Type, Columns> const& y)
+    {
+        std::vector<Type> ret(batch_columns * batch_value * batch_value);
+        for (std::size_t j{}; j < batch_columns; j++) {
+            for (std::size_t k{}; k < batch_value * batch_value; k++) {
+                ret[j * batch_value * batch_value + k] = y[j * batch_value + morton_compact(k)];
+            }
+        }
+        return ret;
+    }
+
+    // Copies a finished tile into the storage, with non-temporal stores when stream_stores is set
+    static void
+    store_tile(Type const* in, Type* out)
+    {
+        constexpr auto size = batch_value * batch_value;
+#if defined(__SSE2__)
+        if constexpr (stream_stores && std::is_trivially_copyable_v<Type> && (16 % sizeof(Type) == 0)) {
+            constexpr auto lane = 16 / sizeof(Type);
+            std::size_t    i{};
+            for (; (i < size) && (reinterpret_cast<std::uintptr_t>(out + i) % 16 != 0); i++) {
+                out[i] = in[i];
+            }
+            for (; i + lane <= size; i += lane) {
+                _mm_stream_si128(reinterpret_cast<__m128i*>(out + i),
+                                 _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i)));
+            }
+            for (; i < size; i++) {
+                out[i] = in[i];
+            }
+            return;
+        }
+#endif
+        std::copy_n(in, size, out);
+    }
+
+    // Orders the streaming stores of this thread before it reports its band as done
+    static void
+    store_fence()
+    {
+#if defined(__SSE2__)
+        if constexpr (stream_stores) {
+            _mm_sfence();
+        }
+#endif
+    }
+
+    // out = alpha * in + beta * out, out is not read when beta == 0
+    static void
+    blend(std::size_t size, Type alpha, Type const* in, Type beta, Type* out)
+    {
+        if (beta == Type{0}) {
+            for (std::size_t i{}; i < size; i++) {
+                out[i] = alpha * in[i];
+            }
+        } else {
+            for (std::size_t i{}; i < size; i++) {
+                out[i] = alpha * in[i] + beta * out[i];
+            }
+        }
+    }
 };
 
 }    // namespace xitren::math
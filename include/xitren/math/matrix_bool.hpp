@@ -0,0 +1,195 @@
+#pragma once
+
+#include <xitren/math/matrix.hpp>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace xitren::math {
+
+/**
+ * Boolean matrix with every row packed into 64-bit words, one bit per element.
+ * Products run over whole words: the OR-AND product ORs rows of the right operand, the counting product is
+ * AND + popcount. Loops over words vectorize, and with VPOPCNT (AVX-512) the popcount does as well.
+ */
+template <std::size_t Rows, std::size_t Columns>
+class matrix_bool {
+public:
+    using word_type = std::uint64_t;
+
+    static constexpr std::size_t word_bits = 64;
+    static constexpr std::size_t row_words = (Columns + word_bits - 1) / word_bits;
+
+    using row_type  = std::array<word_type, row_words>;
+    using data_type = std::array<row_type, Rows>;
+
+    matrix_bool() = default;
+
+    /**
+     * Packs a matrix, every non-zero element becomes a set bit
+     * @param source the matrix to pack
+     */
+    template <class Type, std::size_t Batch>
+    explicit matrix_bool(matrix<Type, Rows, Columns, Batch> const& source)
+    {
+        source.for_each([this](std::size_t row, std::size_t column, Type const& item) {
+            set(row, column, item != Type{});
+        });
+    }
+
+    [[nodiscard]] bool
+    get(std::size_t row, std::size_t column) const
+    {
+        return (data_[row][column / word_bits] >> (column % word_bits)) & 1U;
+    }
+
+    void
+    set(std::size_t row, std::size_t column, bool value = true)
+    {
+        auto const mask = word_type{1} << (column % word_bits);
+        auto&      word = data_[row][column / word_bits];
+        word            = value ? (word | mask) : (word & ~mask);
+    }
+
+    void
+    clear()
+    {
+        data_ = data_type{};
+    }
+
+    [[nodiscard]] row_type const&
+    row(std::size_t row) const
+    {
+        return data_[row];
+    }
+
+    bool
+    operator==(matrix_bool const& other) const
+    {
+        return data_ == other.data_;
+    }
+
+    /**
+     * Returns the number of set elements
+     * @return the number of set bits
+     */
+    [[nodiscard]] std::size_t
+    count() const
+    {
+        std::size_t ret{};
+        for (auto const& line : data_) {
+            for (auto word : line) {
+                ret += static_cast<std::size_t>(std::popcount(word));
+            }
+        }
+        return ret;
+    }
+
+    matrix_bool<Columns, Rows>
+    transpose() const
+    {
+        matrix_bool<Columns, Rows> ret{};
+        for (std::size_t i{}; i < Rows; i++) {
+            for_each_bit(data_[i], [&](std::size_t column) { ret.set(column, i); });
+        }
+        return ret;
+    }
+
+    /**
+     * Boolean (OR-AND semiring) product: ret[i][j] = OR_k (*this)[i][k] AND other[k][j].
+     * Every set bit of a row of *this ORs a whole packed row of other into the result row.
+     * @param other right hand operand
+     * @param ret the result
+     */
+    template <std::size_t ColumnsOther>
+    void
+    mult(matrix_bool<Columns, ColumnsOther> const& other, matrix_bool<Rows, ColumnsOther>& ret) const
+    {
+        for (std::size_t i{}; i < Rows; i++) {
+            typename matrix_bool<Rows, ColumnsOther>::row_type acc{};
+            for_each_bit(data_[i], [&](std::size_t k) {
+                auto const& line = other.row(k);
+                for (std::size_t w{}; w < acc.size(); w++) {
+                    acc[w] |= line[w];
+                }
+            });
+            ret.data_[i] = acc;
+        }
+    }
+
+    /**
+     * Counting product: ret[i][j] is the number of k with (*this)[i][k] AND other[k][j], e.g. the number of
+     * two step paths. Rows of *this and columns of other are ANDed word by word and popcounted.
+     * @param other right hand operand
+     * @param ret the result
+     */
+    template <class Type, std::size_t ColumnsOther, std::size_t Batch>
+    void
+    count(matrix_bool<Columns, ColumnsOther> const& other, matrix<Type, Rows, ColumnsOther, Batch>& ret) const
+    {
+        auto const other_columns = other.transpose();
+        ret.for_each([&](std::size_t row, std::size_t column, Type& item) {
+            auto const& a = data_[row];
+            auto const& b = other_columns.row(column);
+            std::size_t sum{};
+            for (std::size_t w{}; w < row_words; w++) {
+                sum += static_cast<std::size_t>(std::popcount(a[w] & b[w]));
+            }
+            item = static_cast<Type>(sum);
+        });
+    }
+
+    /**
+     * Transitive closure by repeated squaring: R = R OR R * R until nothing changes, at most log2(Rows) products
+     * @param reflexive also mark every element as reachable from itself
+     * @return the closure
+     */
+    [[nodiscard]] matrix_bool
+    closure(bool reflexive = false) const
+    {
+        static_assert(Rows == Columns, "Closure needs a square matrix!");
+        matrix_bool ret{*this};
+        if (reflexive) {
+            for (std::size_t i{}; i < Rows; i++) {
+                ret.set(i, i);
+            }
+        }
+        matrix_bool square{};
+        for (std::size_t step{1}; step < Rows; step <<= 1) {
+            ret.mult(ret, square);
+            bool changed{};
+            for (std::size_t i{}; i < Rows; i++) {
+                for (std::size_t w{}; w < row_words; w++) {
+                    auto const next = ret.data_[i][w] | square.data_[i][w];
+                    changed |= (next != ret.data_[i][w]);
+                    ret.data_[i][w] = next;
+                }
+            }
+            if (!changed) {
+                break;
+            }
+        }
+        return ret;
+    }
+
+    template <std::size_t R, std::size_t C>
+    friend class matrix_bool;
+
+private:
+    data_type data_{};
+
+    template <class Func>
+    static void
+    for_each_bit(row_type const& line, Func func)
+    {
+        for (std::size_t w{}; w < row_words; w++) {
+            for (auto word = line[w]; word != 0; word &= word - 1) {
+                func(w * word_bits + static_cast<std::size_t>(std::countr_zero(word)));
+            }
+        }
+    }
+};
+
+}    // namespace xitren::math
@@ -1,12 +1,12 @@
 #pragma once
 
+#include <xitren/math/random.hpp>
+
 #include <array>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
-#include <cstdlib>
 #include <cstring>
-#include <ctime>
 #include <vector>
 
 namespace xitren::math {
@@ -95,14 +95,23 @@ public:
     static matrix_classic
     get_rand_matrix()
     {
-        std::srand(std::time({}));    // use current time as seed for random generator
-        data_type data_rand;
-        for (auto it{data_rand.begin()}; it != data_rand.end(); it++) {
-            for (auto it2{(*it).begin()}; it2 != ((*it).end()); it2++) {
-                (*it2) = static_cast<Type>(std::rand());
-            }
+        return get_rand_matrix(counter_random::seed());
+    }
+
+    /**
+     * Creates a reproducible random matrix, element (row, column) is the position row * Columns + column
+     * of the counter_random stream
+     * @param seed the stream seed
+     * @return the random matrix
+     */
+    static matrix_classic
+    get_rand_matrix(std::uint64_t seed)
+    {
+        matrix_classic ret;
+        for (std::size_t i = 0; i < Rows; i++) {
+            counter_random::fill(ret[i].data(), Columns, seed, i * Columns);
         }
-        return matrix_classic{data_rand};
+        return ret;
     }
 };
 
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <xitren/math/matrix.hpp>
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace xitren::math {
+
+/**
+ * Complex matrix with split storage: the real and the imaginary parts are two tiled real matrices.
+ * Products run on the real GEMM kernels instead of scalar std::complex multiplies.
+ */
+template <class Type, std::size_t Rows, std::size_t Columns, std::size_t Batch = 0>
+class matrix_complex {
+public:
+    using real_type  = matrix<Type, Rows, Columns, Batch>;
+    using value_type = std::complex<Type>;
+
+    static constexpr auto batch_value = real_type::batch_value;
+
+    matrix_complex() = default;
+
+    value_type
+    get(std::size_t row, std::size_t column) const
+    {
+        return {real_.get(row, column), imag_.get(row, column)};
+    }
+
+    void
+    set(std::size_t row, std::size_t column, value_type value)
+    {
+        real_.get(row, column) = value.real();
+        imag_.get(row, column) = value.imag();
+    }
+
+    real_type&
+    real()
+    {
+        return real_;
+    }
+
+    real_type const&
+    real() const
+    {
+        return real_;
+    }
+
+    real_type&
+    imag()
+    {
+        return imag_;
+    }
+
+    real_type const&
+    imag() const
+    {
+        return imag_;
+    }
+
+    template <class T, std::size_t R, std::size_t C, std::size_t B>
+    friend class matrix_complex;
+
+    /**
+     * Complex product by the 3M method, three real products instead of four:
+     * re = Ar * Br - Ai * Bi, im = (Ar + Ai) * (Br + Bi) - Ar * Br - Ai * Bi.
+     * The additions are O(n^2), so for large matrices it costs about 3/4 of mult_4m.
+     * @param other right hand operand
+     * @param ret the result, should not alias the operands
+     */
+    template <std::size_t ColumnsOther>
+    void
+    mult(matrix_complex<Type, Columns, ColumnsOther, Batch> const& other,
+         matrix_complex<Type, Rows, ColumnsOther, Batch>&       ret) const
+    {
+        using other_real_type = matrix<Type, Columns, ColumnsOther, Batch>;
+        using ret_real_type   = matrix<Type, Rows, ColumnsOther, Batch>;
+
+        auto sum_this  = std::make_unique<real_type>();
+        auto sum_other = std::make_unique<other_real_type>();
+        auto imag_imag = std::make_unique<ret_real_type>();
+        real_.add(imag_, *sum_this);
+        other.real_.add(other.imag_, *sum_other);
+
+        real_.mult(other.real_, ret.real_);
+        imag_.mult(other.imag_, *imag_imag);
+        sum_this->mult(*sum_other, ret.imag_);
+        // im -= Ar * Br + Ai * Bi, re -= Ai * Bi
+        ret.real_.axpy(Type{-1}, ret.imag_, ret.imag_);
+        imag_imag->axpy(Type{-1}, ret.imag_, ret.imag_);
+        imag_imag->axpy(Type{-1}, ret.real_, ret.real_);
+    }
+
+    /**
+     * Complex product by four real products: re = Ar * Br - Ai * Bi, im = Ar * Bi + Ai * Br.
+     * Slower than mult, but it rounds like the textbook formula.
+     * @param other right hand operand
+     * @param ret the result, should not alias the operands
+     */
+    template <std::size_t ColumnsOther>
+    void
+    mult_4m(matrix_complex<Type, Columns, ColumnsOther, Batch> const& other,
+            matrix_complex<Type, Rows, ColumnsOther, Batch>&       ret) const
+    {
+        real_.mult(other.real_, ret.real_);
+        imag_.gemm(Type{-1}, other.imag_, Type{1}, ret.real_);
+        real_.mult(other.imag_, ret.imag_);
+        imag_.gemm(Type{1}, other.real_, Type{1}, ret.imag_);
+    }
+
+    void
+    add(matrix_complex const& other, matrix_complex& ret) const
+    {
+        real_.add(other.real_, ret.real_);
+        imag_.add(other.imag_, ret.imag_);
+    }
+
+    void
+    sub(matrix_complex const& other, matrix_complex& ret) const
+    {
+        real_.sub(other.real_, ret.real_);
+        imag_.sub(other.imag_, ret.imag_);
+    }
+
+    /**
+     * Complex conjugate: ret = conj(*this)
+     * @param ret the result, may be *this
+     */
+    void
+    conj(matrix_complex& ret) const
+    {
+        ret.real_ = real_;
+        imag_.scale(Type{-1}, ret.imag_);
+    }
+
+    static matrix_complex
+    get_rand_matrix()
+    {
+        return get_rand_matrix(counter_random::seed());
+    }
+
+    /**
+     * Creates a reproducible random matrix, the real part uses the stream seed, the imaginary one seed + 1
+     * @param seed the stream seed
+     * @return the random matrix
+     */
+    static matrix_complex
+    get_rand_matrix(std::uint64_t seed)
+    {
+        matrix_complex ret{};
+        ret.real_ = real_type::get_rand_matrix(seed);
+        ret.imag_ = real_type::get_rand_matrix(seed + 1);
+        return ret;
+    }
+
+private:
+    real_type real_{};
+    real_type imag_{};
+};
+
+}    // namespace xitren::math
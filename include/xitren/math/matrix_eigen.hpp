@@ -0,0 +1,554 @@
+#pragma once
+
+#include <xitren/math/matrix.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace xitren::math {
+
+/**
+ * Eigen decomposition of a symmetric Size x Size matrix: A = Z * diag(values) * Z^T.
+ * The matrix is reduced to tridiagonal form by Householder reflectors, the tridiagonal problem is solved by
+ * Cuppen's divide and conquer and the eigenvectors are transformed back.
+ * The cubic parts (the trailing updates of the blocked reduction, the eigenvector updates of every merge and
+ * the back transformation) are tiled GEMMs.
+ * Split sizes are compile-time, so the divide and conquer tree is unrolled by template recursion.
+ */
+template <class Type, std::size_t Size, std::size_t Batch = 32>
+class symmetric_eigen {
+    static_assert(Size > 1);
+    static_assert(Batch >= 2 && (Batch & (Batch - 1)) == 0, "Batch should be an explicit power of 2!");
+
+    // Subproblems up to this size are solved directly by the implicit QL iteration
+    static constexpr std::size_t leaf_size = 32;
+
+public:
+    using matrix_type = matrix<Type, Size, Size, Batch>;
+
+    /**
+     * Decomposes the matrix, only its lower triangle is read
+     * @param a the symmetric matrix
+     */
+    explicit symmetric_eigen(matrix_type const& a) : values_(Size), vectors_{std::make_unique<matrix_type>()}
+    {
+        std::vector<Type> work(Size * Size);
+        a.for_each([&work](std::size_t row, std::size_t column, Type const& item) {
+            if (column <= row) {
+                work[row * Size + column] = item;
+                work[column * Size + row] = item;
+            }
+        });
+        std::vector<Type> off(Size);
+        std::vector<Type> z(Size * Size);
+        tridiagonalize(work.data(), values_.data(), off.data());
+        solve_tridiagonal<Size>(values_.data(), off.data(), z.data());
+
+        // Ascending eigenvalues, eigenvector columns follow
+        std::vector<std::size_t> order(Size);
+        std::iota(order.begin(), order.end(), std::size_t{});
+        std::sort(order.begin(), order.end(), [this](std::size_t l, std::size_t r) { return values_[l] < values_[r]; });
+        auto const sorted_values = values_;
+        for (std::size_t i{}; i < Size; i++) {
+            values_[i] = sorted_values[order[i]];
+        }
+        auto tridiagonal_vectors = std::make_unique<matrix_type>();
+        tridiagonal_vectors->for_each(
+            [&](std::size_t row, std::size_t column, Type& item) { item = z[row * Size + order[column]]; });
+        auto reflectors = std::make_unique<matrix_type>();
+        accumulate(work.data(), *reflectors);
+        reflectors->mult(*tridiagonal_vectors, *vectors_);
+    }
+
+    /**
+     * Returns the eigenvalues in ascending order
+     * @return the eigenvalues
+     */
+    [[nodiscard]] std::vector<Type> const&
+    values() const
+    {
+        return values_;
+    }
+
+    /**
+     * Returns the orthonormal eigenvectors, column i belongs to values()[i]
+     * @return the eigenvectors
+     */
+    [[nodiscard]] matrix_type const&
+    vectors() const
+    {
+        return *vectors_;
+    }
+
+private:
+    std::vector<Type>            values_;
+    std::unique_ptr<matrix_type> vectors_;
+    std::vector<Type>            tau_ = std::vector<Type>(Size);
+
+    /**
+     * Householder reduction of the full row-major symmetric a to tridiagonal form with diagonal d and
+     * off-diagonal e. Reflector k is kept below the subdiagonal of column k.
+     * Panels of Batch reflectors are built against the panel start matrix and the growing V, W of the panel
+     * (LAPACK latrd), the trailing block then takes the whole panel as the GEMM update A -= V * W^T + W * V^T.
+     */
+    void
+    tridiagonalize(Type* a, Type* d, Type* e)
+    {
+        reduce_from<0>(a, d, e);
+        d[Size - 2] = a[(Size - 2) * Size + Size - 2];
+        d[Size - 1] = a[(Size - 1) * Size + Size - 1];
+        e[Size - 2] = a[(Size - 1) * Size + Size - 2];
+        e[Size - 1] = Type{};
+    }
+
+    // Matrix types need both dimensions above one, unused padding stays zero
+    static constexpr std::size_t
+    dim(std::size_t size)
+    {
+        return std::max<std::size_t>(size, 2);
+    }
+
+    template <std::size_t First>
+    void
+    reduce_from(Type* a, Type* d, Type* e)
+    {
+        if constexpr (First + 2 < Size) {
+            constexpr auto w    = std::min(Batch, Size - 2 - First);
+            constexpr auto next = First + w;
+            // Rows First..Size of the panel reflectors V and their updates W, row-major with w columns
+            std::vector<Type> v((Size - First) * w);
+            std::vector<Type> p((Size - First) * w);
+            reduce_panel(First, w, a, d, e, v.data(), p.data());
+            update_trailing<next, w>(a, v.data() + (next - First) * w, p.data() + (next - First) * w);
+            reduce_from<next>(a, d, e);
+        }
+    }
+
+    // Reflectors of columns [first, first + w), a outside the panel columns stays at the panel start matrix
+    void
+    reduce_panel(std::size_t first, std::size_t w, Type* a, Type* d, Type* e, Type* v, Type* p)
+    {
+        std::vector<Type> vw(w);
+        std::vector<Type> vv(w);
+        for (std::size_t i{}; i < w; i++) {
+            auto const k = first + i;
+            // Column k gets the updates of the previous reflectors of the panel
+            for (std::size_t r{k}; r < Size; r++) {
+                Type const* v_row = &v[(r - first) * w];
+                Type const* p_row = &p[(r - first) * w];
+                Type const* v_k   = &v[(k - first) * w];
+                Type const* p_k   = &p[(k - first) * w];
+                Type        sum{};
+                for (std::size_t j{}; j < i; j++) {
+                    sum += v_row[j] * p_k[j] + p_row[j] * v_k[j];
+                }
+                a[r * Size + k] -= sum;
+            }
+            Type const alpha = a[(k + 1) * Size + k];
+            Type       sigma{};
+            for (std::size_t r{k + 2}; r < Size; r++) {
+                sigma += a[r * Size + k] * a[r * Size + k];
+            }
+            d[k] = a[k * Size + k];
+            if (sigma == Type{}) {
+                tau_[k] = Type{};
+                e[k]    = alpha;
+                continue;
+            }
+            Type const norm  = std::sqrt(alpha * alpha + sigma);
+            Type const beta  = (alpha <= Type{}) ? norm : -norm;
+            Type const scale = Type{1} / (alpha - beta);
+            Type const tau   = (beta - alpha) / beta;
+            tau_[k]          = tau;
+            e[k]             = beta;
+
+            v[(k + 1 - first) * w + i] = Type{1};
+            for (std::size_t r{k + 2}; r < Size; r++) {
+                a[r * Size + k] *= scale;
+                v[(r - first) * w + i] = a[r * Size + k];
+            }
+            // p_i = tau * (A - V * W^T - W * V^T) * v_i over the rows below k
+            std::fill(vw.begin(), vw.end(), Type{});
+            std::fill(vv.begin(), vv.end(), Type{});
+            for (std::size_t r{k + 1}; r < Size; r++) {
+                Type const  vr    = v[(r - first) * w + i];
+                Type const* v_row = &v[(r - first) * w];
+                Type const* p_row = &p[(r - first) * w];
+                for (std::size_t j{}; j < i; j++) {
+                    vw[j] += p_row[j] * vr;
+                    vv[j] += v_row[j] * vr;
+                }
+            }
+            Type pv{};
+            for (std::size_t r{k + 1}; r < Size; r++) {
+                Type const* row   = &a[r * Size];
+                Type const* v_row = &v[(r - first) * w];
+                Type const* p_row = &p[(r - first) * w];
+                Type        sum{};
+                for (std::size_t c{k + 1}; c < Size; c++) {
+                    sum += row[c] * v[(c - first) * w + i];
+                }
+                for (std::size_t j{}; j < i; j++) {
+                    sum -= v_row[j] * vw[j] + p_row[j] * vv[j];
+                }
+                p[(r - first) * w + i] = tau * sum;
+                pv += tau * sum * v_row[i];
+            }
+            Type const half = tau * pv / Type{2};
+            for (std::size_t r{k + 1}; r < Size; r++) {
+                p[(r - first) * w + i] -= half * v[(r - first) * w + i];
+            }
+        }
+    }
+
+    // Trailing block from row and column First: A -= [V W] * [W V]^T as one tiled GEMM
+    template <std::size_t First, std::size_t W>
+    static void
+    update_trailing(Type* a, Type const* v, Type const* p)
+    {
+        constexpr auto m = Size - First;
+
+        using left_type  = matrix<Type, dim(m), 2 * W, Batch>;
+        using right_type = matrix<Type, 2 * W, dim(m), Batch>;
+        using trail_type = matrix<Type, dim(m), dim(m), Batch>;
+
+        auto left  = std::make_unique<left_type>();
+        auto right = std::make_unique<right_type>();
+        auto trail = std::make_unique<trail_type>();
+        left->for_each([&](std::size_t row, std::size_t column, Type& item) {
+            if (row < m) {
+                item = (column < W) ? v[row * W + column] : p[row * W + column - W];
+            }
+        });
+        right->for_each([&](std::size_t row, std::size_t column, Type& item) {
+            if (column < m) {
+                item = (row < W) ? p[column * W + row] : v[column * W + row - W];
+            }
+        });
+        trail->for_each([&](std::size_t row, std::size_t column, Type& item) {
+            if ((row < m) && (column < m)) {
+                item = a[(First + row) * Size + First + column];
+            }
+        });
+        left->gemm(Type{-1}, *right, Type{1}, *trail);
+        trail->for_each([&](std::size_t row, std::size_t column, Type const& item) {
+            if ((row < m) && (column < m)) {
+                a[(First + row) * Size + First + column] = item;
+            }
+        });
+    }
+
+    // Builds Q = H_0 * H_1 * ... from the stored reflectors, applied backwards so only the trailing block changes
+    void
+    accumulate(Type const* a, matrix_type& ret) const
+    {
+        std::vector<Type> q(Size * Size);
+        std::vector<Type> s(Size);
+        for (std::size_t i{}; i < Size; i++) {
+            q[i * Size + i] = Type{1};
+        }
+        for (std::size_t k{Size - 2}; k-- > 0;) {
+            auto const first = k + 1;
+            Type const tau   = tau_[k];
+            if (tau == Type{}) {
+                continue;
+            }
+            // s = v^T * Q, then Q -= tau * v * s
+            std::fill(s.begin() + static_cast<std::ptrdiff_t>(first), s.end(), Type{});
+            for (std::size_t i{first}; i < Size; i++) {
+                Type const  vi  = (i == first) ? Type{1} : a[i * Size + k];
+                Type const* row = &q[i * Size];
+                for (std::size_t j{first}; j < Size; j++) {
+                    s[j] += vi * row[j];
+                }
+            }
+            for (std::size_t i{first}; i < Size; i++) {
+                Type const vi  = tau * ((i == first) ? Type{1} : a[i * Size + k]);
+                Type*      row = &q[i * Size];
+                for (std::size_t j{first}; j < Size; j++) {
+                    row[j] -= vi * s[j];
+                }
+            }
+        }
+        ret.for_each([&q](std::size_t row, std::size_t column, Type& item) { item = q[row * Size + column]; });
+    }
+
+    /**
+     * Eigen decomposition of the N x N tridiagonal (d, e), e[i] couples i and i + 1.
+     * d gets the eigenvalues, z the row-major eigenvectors as columns.
+     */
+    template <std::size_t N>
+    static void
+    solve_tridiagonal(Type* d, Type* e, Type* z)
+    {
+        if constexpr (N <= leaf_size) {
+            ql(N, d, e, z);
+        } else {
+            constexpr auto first  = N / 2;
+            constexpr auto second = N - first;
+            // T = diag(T1, T2) + rho * v * v^T with v = e_{first - 1} + e_first
+            Type const rho = e[first - 1];
+            d[first - 1] -= rho;
+            d[first] -= rho;
+            std::vector<Type> q1(first * first);
+            std::vector<Type> q2(second * second);
+            solve_tridiagonal<first>(d, e, q1.data());
+            solve_tridiagonal<second>(d + first, e + first, q2.data());
+            merge<N, first>(d, rho, q1.data(), q2.data(), z);
+        }
+    }
+
+    // Implicit QL iteration with Wilkinson shifts, z starts as the identity and accumulates the rotations
+    static void
+    ql(std::size_t n, Type* d, Type* e, Type* z)
+    {
+        std::fill(z, z + n * n, Type{});
+        for (std::size_t i{}; i < n; i++) {
+            z[i * n + i] = Type{1};
+        }
+        e[n - 1] = Type{};
+        for (std::size_t l{}; l < n; l++) {
+            for (std::size_t iteration{}; iteration < 64; iteration++) {
+                std::size_t m{l};
+                for (; m + 1 < n; m++) {
+                    Type const dd = std::abs(d[m]) + std::abs(d[m + 1]);
+                    if (std::abs(e[m]) <= std::numeric_limits<Type>::epsilon() * dd) {
+                        break;
+                    }
+                }
+                if (m == l) {
+                    break;
+                }
+                Type g = (d[l + 1] - d[l]) / (Type{2} * e[l]);
+                Type r = std::hypot(g, Type{1});
+                g      = d[m] - d[l] + e[l] / (g + std::copysign(r, g));
+                Type s{1};
+                Type c{1};
+                Type p{};
+                bool underflow{};
+                for (std::size_t i{m}; i-- > l;) {
+                    Type const f = s * e[i];
+                    Type const b = c * e[i];
+                    r            = std::hypot(f, g);
+                    e[i + 1]     = r;
+                    if (r == Type{}) {
+                        d[i + 1] -= p;
+                        e[m]      = Type{};
+                        underflow = true;
+                        break;
+                    }
+                    s        = f / r;
+                    c        = g / r;
+                    g        = d[i + 1] - p;
+                    r        = (d[i] - g) * s + Type{2} * c * b;
+                    p        = s * r;
+                    d[i + 1] = g + p;
+                    g        = c * r - b;
+                    for (std::size_t k{}; k < n; k++) {
+                        Type const t    = z[k * n + i + 1];
+                        z[k * n + i + 1] = s * z[k * n + i] + c * t;
+                        z[k * n + i]     = c * z[k * n + i] - s * t;
+                    }
+                }
+                if (underflow) {
+                    continue;
+                }
+                d[l] -= p;
+                e[l] = g;
+                e[m] = Type{};
+            }
+        }
+    }
+
+    /**
+     * Merges the halves: diag(Q1, Q2) * (D + rho * z * z^T) * diag(Q1, Q2)^T.
+     * Small z components and close poles are deflated, the rest of the spectrum comes from the secular
+     * equation and the vectors from the Gu-Eisenstat formula, so they stay orthogonal.
+     */
+    template <std::size_t N, std::size_t First>
+    static void
+    merge(Type* d, Type rho, Type const* q1, Type const* q2, Type* out)
+    {
+        constexpr auto second = N - First;
+        constexpr auto eps    = std::numeric_limits<Type>::epsilon();
+
+        std::vector<Type> z(N);
+        for (std::size_t i{}; i < First; i++) {
+            z[i] = q1[(First - 1) * First + i];
+        }
+        for (std::size_t i{}; i < second; i++) {
+            z[First + i] = q2[i];
+        }
+        // Normalized z and positive rho, a negative rho mirrors the spectrum
+        Type const sign = (rho < Type{}) ? Type{-1} : Type{1};
+        Type       norm{};
+        for (auto item : z) {
+            norm += item * item;
+        }
+        norm = std::sqrt(norm);
+        for (auto& item : z) {
+            item /= norm;
+        }
+        rho = std::abs(rho) * norm * norm;
+        std::vector<Type> poles(N);
+        for (std::size_t i{}; i < N; i++) {
+            poles[i] = sign * d[i];
+        }
+
+        std::vector<std::size_t> order(N);
+        std::iota(order.begin(), order.end(), std::size_t{});
+        std::sort(order.begin(), order.end(), [&poles](std::size_t l, std::size_t r) { return poles[l] < poles[r]; });
+        Type scale{rho};
+        for (auto item : poles) {
+            scale = std::max(scale, std::abs(item));
+        }
+        Type const tol = Type{8} * eps * scale;
+
+        // Deflation: negligible weights and Givens rotations merging close poles
+        std::vector<Type>        w(N * N);
+        std::vector<std::size_t> kept;
+        struct rotation {
+            std::size_t first;
+            std::size_t second;
+            Type        c;
+            Type        s;
+        };
+        std::vector<rotation> rotations;
+        std::vector<Type>     lambda(N);
+        for (auto index : order) {
+            if (rho * std::abs(z[index]) <= tol) {
+                w[index * N + index] = Type{1};
+                lambda[index]        = poles[index];
+                continue;
+            }
+            if (!kept.empty() && (poles[index] - poles[kept.back()] <= tol)) {
+                auto const previous = kept.back();
+                Type const r        = std::hypot(z[previous], z[index]);
+                rotations.push_back({previous, index, z[index] / r, z[previous] / r});
+                z[previous]                = Type{};
+                z[index]                   = r;
+                w[previous * N + previous] = Type{1};
+                lambda[previous]           = poles[previous];
+                kept.back()                = index;
+                continue;
+            }
+            kept.push_back(index);
+        }
+
+        // Secular equation 1 + rho * sum z_i^2 / (p_i - lambda) = 0, every root is kept as origin pole + tau
+        auto const               count = kept.size();
+        std::vector<std::size_t> origin(count);
+        std::vector<Type>        tau(count);
+        auto const               secular = [&](std::size_t from, Type t) {
+            Type sum{};
+            for (std::size_t i{}; i < count; i++) {
+                auto const k = kept[i];
+                sum += z[k] * z[k] / ((poles[k] - poles[from]) - t);
+            }
+            return Type{1} + rho * sum;
+        };
+        for (std::size_t j{}; j < count; j++) {
+            Type lo{};
+            Type hi{};
+            auto from = kept[j];
+            if (j + 1 < count) {
+                Type const gap = poles[kept[j + 1]] - poles[from];
+                if (secular(from, gap / Type{2}) >= Type{}) {
+                    hi = gap / Type{2};
+                } else {
+                    from = kept[j + 1];
+                    lo   = -gap / Type{2};
+                }
+            } else {
+                Type weight{};
+                for (auto k : kept) {
+                    weight += z[k] * z[k];
+                }
+                hi = rho * weight;
+            }
+            for (std::size_t iteration{}; iteration < 128; iteration++) {
+                Type const mid = lo + (hi - lo) / Type{2};
+                if ((mid <= lo) || (mid >= hi)) {
+                    break;
+                }
+                if (secular(from, mid) < Type{}) {
+                    lo = mid;
+                } else {
+                    hi = mid;
+                }
+            }
+            origin[j] = from;
+            tau[j]    = lo + (hi - lo) / Type{2};
+        }
+        // p_i - lambda_j without cancellation
+        auto const gap = [&](std::size_t i, std::size_t j) {
+            return (poles[kept[i]] - poles[origin[j]]) - tau[j];
+        };
+
+        // Gu-Eisenstat: weights for which the computed roots are exact, then normalized vectors
+        std::vector<Type> weights(count);
+        for (std::size_t i{}; i < count; i++) {
+            Type product = -gap(i, count - 1) / rho;
+            for (std::size_t j{}; j < i; j++) {
+                product *= gap(i, j) / (poles[kept[i]] - poles[kept[j]]);
+            }
+            for (std::size_t j{i}; j + 1 < count; j++) {
+                product *= gap(i, j) / (poles[kept[i]] - poles[kept[j + 1]]);
+            }
+            weights[i] = std::copysign(std::sqrt(std::abs(product)), z[kept[i]]);
+        }
+        std::vector<Type> u(count);
+        for (std::size_t j{}; j < count; j++) {
+            Type length{};
+            for (std::size_t i{}; i < count; i++) {
+                u[i] = weights[i] / gap(i, j);
+                length += u[i] * u[i];
+            }
+            length = std::sqrt(length);
+            for (std::size_t i{}; i < count; i++) {
+                w[kept[i] * N + kept[j]] = u[i] / length;
+            }
+            lambda[kept[j]] = poles[origin[j]] + tau[j];
+        }
+        // Undo the deflation rotations on the rows of W
+        for (auto it = rotations.rbegin(); it != rotations.rend(); it++) {
+            Type* row_first  = &w[it->first * N];
+            Type* row_second = &w[it->second * N];
+            for (std::size_t column{}; column < N; column++) {
+                Type const a       = row_first[column];
+                Type const b       = row_second[column];
+                row_first[column]  = it->c * a + it->s * b;
+                row_second[column] = it->c * b - it->s * a;
+            }
+        }
+        for (std::size_t i{}; i < N; i++) {
+            d[i] = sign * lambda[i];
+        }
+
+        // Eigenvectors: Q1 * W(0:First, :) and Q2 * W(First:N, :)
+        block_product<First, N>(q1, w.data(), out);
+        block_product<second, N>(q2, w.data() + First * N, out + First * N);
+    }
+
+    // out (Rows x N) = q (Rows x Rows) * w (Rows x N), all row-major
+    template <std::size_t Rows, std::size_t N>
+    static void
+    block_product(Type const* q, Type const* w, Type* out)
+    {
+        auto mq = std::make_unique<matrix<Type, Rows, Rows, Batch>>();
+        auto mw = std::make_unique<matrix<Type, Rows, N, Batch>>();
+        auto mo = std::make_unique<matrix<Type, Rows, N, Batch>>();
+        mq->for_each([q](std::size_t row, std::size_t column, Type& item) { item = q[row * Rows + column]; });
+        mw->for_each([w](std::size_t row, std::size_t column, Type& item) { item = w[row * N + column]; });
+        mq->mult(*mw, *mo);
+        mo->for_each([out](std::size_t row, std::size_t column, Type const& item) { out[row * N + column] = item; });
+    }
+};
+
+}    // namespace xitren::math
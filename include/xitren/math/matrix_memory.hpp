@@ -0,0 +1,219 @@
+#pragma once
+
+#include <xitren/math/matrix.hpp>
+#include <xitren/math/parallel.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+#endif
+
+namespace xitren::math {
+
+/**
+ * Page placement of a dynamically allocated matrix
+ */
+enum class numa_placement {
+    first_touch,    // pages go to the node of the thread that first writes them, see make_matrix
+    interleave,     // pages are spread round robin over all memory nodes
+    bind            // pages are bound to memory_policy::node
+};
+
+/**
+ * Allocation policy of make_matrix
+ */
+struct memory_policy {
+    numa_placement placement{numa_placement::interleave};
+    bool           huge_pages{false};    // 2 MB transparent huge pages, cuts TLB misses on large matrices
+    int            node{0};              // the node of numa_placement::bind
+};
+
+/**
+ * Returns the memory nodes of the machine
+ * @return the ids of the nodes with memory, a single node 0 when NUMA is not exposed
+ */
+inline std::vector<int>
+numa_nodes()
+{
+    std::vector<int> nodes;
+#if defined(__linux__)
+    std::error_code error;
+    for (auto const& entry : std::filesystem::directory_iterator{"/sys/devices/system/node", error}) {
+        auto const name = entry.path().filename().string();
+        if ((name.size() > 4) && (name.compare(0, 4, "node") == 0)
+            && (name.find_first_not_of("0123456789", 4) == std::string::npos)) {
+            nodes.push_back(std::stoi(name.substr(4)));
+        }
+    }
+    std::sort(nodes.begin(), nodes.end());
+#endif
+    if (nodes.empty()) {
+        nodes.push_back(0);
+    }
+    return nodes;
+}
+
+/**
+ * Returns the CPUs of a memory node
+ * @param node the node id
+ * @return the ids from the node cpulist, empty when NUMA is not exposed
+ */
+inline std::vector<int>
+numa_cpus(int node)
+{
+    std::vector<int> cpus;
+#if defined(__linux__)
+    std::ifstream file{"/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"};
+    std::string   range;
+    while (std::getline(file, range, ',')) {
+        int                first{};
+        int                last{};
+        char               dash{};
+        std::istringstream stream{range};
+        if (!(stream >> first)) {
+            continue;
+        }
+        last = (stream >> dash >> last) ? last : first;
+        for (int cpu{first}; cpu <= last; cpu++) {
+            cpus.push_back(cpu);
+        }
+    }
+#else
+    (void)node;
+#endif
+    return cpus;
+}
+
+/**
+ * Releases matrices created by make_matrix
+ */
+template <class Matrix>
+struct mapped_deleter {
+    std::size_t bytes{};
+
+    void
+    operator()(Matrix* ptr) const
+    {
+        ptr->~Matrix();
+#if defined(__linux__)
+        ::munmap(ptr, bytes);
+#else
+        ::operator delete(ptr, std::align_val_t{alignof(Matrix)});
+#endif
+    }
+};
+
+template <class Matrix>
+using matrix_ptr = std::unique_ptr<Matrix, mapped_deleter<Matrix>>;
+
+namespace detail {
+
+inline constexpr std::size_t huge_page_size = std::size_t{2} << 20;
+
+#if defined(__linux__)
+// Maps bytes of anonymous memory aligned to alignment by trimming an oversized mapping
+inline void*
+map_aligned(std::size_t bytes, std::size_t alignment)
+{
+    auto const total = bytes + alignment;
+    void*      raw   = ::mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        throw std::bad_alloc{};
+    }
+    auto const begin   = reinterpret_cast<std::uintptr_t>(raw);
+    auto const aligned = (begin + alignment - 1) / alignment * alignment;
+    if (aligned > begin) {
+        ::munmap(raw, aligned - begin);
+    }
+    if (auto const tail = begin + total - (aligned + bytes); tail > 0) {
+        ::munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+    }
+    return reinterpret_cast<void*>(aligned);
+}
+
+// The policy is a hint: kernels without NUMA support reject mbind and the pages stay first touch
+inline void
+apply_placement(void* ptr, std::size_t bytes, memory_policy const& policy)
+{
+    if (policy.huge_pages) {
+        ::madvise(ptr, bytes, MADV_HUGEPAGE);
+    }
+    if (policy.placement == numa_placement::first_touch) {
+        return;
+    }
+    std::vector<int> nodes{policy.node};
+    int              mode{MPOL_BIND};
+    if (policy.placement == numa_placement::interleave) {
+        nodes = numa_nodes();
+        mode  = MPOL_INTERLEAVE;
+    }
+    constexpr std::size_t word_bits = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> mask((static_cast<std::size_t>(nodes.back()) + word_bits) / word_bits);
+    for (auto node : nodes) {
+        mask[static_cast<std::size_t>(node) / word_bits] |= 1UL << (static_cast<std::size_t>(node) % word_bits);
+    }
+    ::syscall(SYS_mbind, ptr, bytes, mode, mask.data(), mask.size() * word_bits, 0);
+}
+#endif
+
+}    // namespace detail
+
+/**
+ * Allocates a zeroed matrix with an explicit page placement.
+ * The default interleaves the pages over the nodes, which balances the bandwidth of products whose worker
+ * threads run anywhere. The tile rows are zeroed in parallel on fresh, unpinned threads, so with
+ * numa_placement::first_touch a page lands on whatever node its zeroing thread ran on. It matches the threads
+ * of a later product only when the caller pins both sets of threads itself.
+ * @param policy the placement and page size
+ * @return the matrix
+ */
+template <class Matrix>
+matrix_ptr<Matrix>
+make_matrix(memory_policy const& policy = {})
+{
+    static_assert(std::is_trivially_destructible_v<Matrix>,
+                  "Matrix storage is released as raw memory!");
+    std::size_t bytes{sizeof(Matrix)};
+#if defined(__linux__)
+    auto const page      = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    auto const alignment = policy.huge_pages ? detail::huge_page_size : page;
+    bytes                = (bytes + alignment - 1) / alignment * alignment;
+    void* memory         = detail::map_aligned(bytes, alignment);
+    detail::apply_placement(memory, bytes, policy);
+#else
+    void* memory = ::operator new(bytes, std::align_val_t{alignof(Matrix)});
+#endif
+    auto* ret = new (memory) Matrix;
+    parallel_for(Matrix::batch_rows, 1, [ret](std::size_t begin, std::size_t end) {
+        for (std::size_t i{begin}; i < end; i++) {
+            for (std::size_t j{}; j < Matrix::batch_columns; j++) {
+                ret->batch(i, j).clear();
+            }
+        }
+    });
+    for (std::size_t row{}; row < Matrix::batch_rows_end + Matrix::rest_rows; row++) {
+        auto const first = (row < Matrix::batch_rows_end) ? Matrix::batch_columns_end : std::size_t{};
+        for (std::size_t column{first}; column < Matrix::batch_columns_end + Matrix::rest_columns; column++) {
+            ret->get(row, column) = {};
+        }
+    }
+    return matrix_ptr<Matrix>{ret, mapped_deleter<Matrix>{bytes}};
+}
+
+}    // namespace xitren::math
@@ -0,0 +1,315 @@
+#pragma once
+
+#include <xitren/math/matrix.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace xitren::math {
+
+/**
+ * A matrix kept on disk as a grid of batch tiles.
+ * Tiles are stored in row-major tile order, each one as the raw Z-order storage of matrix_strassen,
+ * so a tile is read or written with a single contiguous transfer.
+ * Every transfer opens its own stream, so tiles can be read from several threads at once.
+ */
+template <class Type, std::size_t Batch>
+class tile_file {
+public:
+    using tile_type = matrix_strassen<Type, Batch>;
+
+    static constexpr std::size_t tile_bytes = sizeof(tile_type);
+
+    /**
+     * Opens the tile file, creating a zero filled one if it does not exist.
+     * Throws if an existing file does not hold exactly the requested tile grid
+     * @param path the file path
+     * @param tile_rows the number of tile rows
+     * @param tile_columns the number of tile columns
+     */
+    tile_file(std::filesystem::path path, std::size_t tile_rows, std::size_t tile_columns)
+        : path_{std::move(path)}, tile_rows_{tile_rows}, tile_columns_{tile_columns}
+    {
+        auto const bytes = tile_rows_ * tile_columns_ * tile_bytes;
+        if (!std::filesystem::exists(path_)) {
+            {
+                std::ofstream create{path_, std::ios::binary};
+                if (!create) {
+                    throw std::runtime_error{"tile_file: can not create " + path_.string()};
+                }
+            }
+            std::filesystem::resize_file(path_, bytes);
+        } else if (std::filesystem::file_size(path_) != bytes) {
+            throw std::invalid_argument{"tile_file: size of " + path_.string() + " does not match the tile grid"};
+        }
+    }
+
+    [[nodiscard]] std::size_t
+    tile_rows() const
+    {
+        return tile_rows_;
+    }
+
+    [[nodiscard]] std::size_t
+    tile_columns() const
+    {
+        return tile_columns_;
+    }
+
+    [[nodiscard]] std::filesystem::path const&
+    path() const
+    {
+        return path_;
+    }
+
+    /**
+     * Reads the tile at the given tile position
+     * @param row the tile row
+     * @param column the tile column
+     * @param tile the destination
+     */
+    void
+    read(std::size_t row, std::size_t column, tile_type& tile) const
+    {
+        std::ifstream stream{path_, std::ios::binary};
+        stream.seekg(static_cast<std::streamoff>(offset(row, column)));
+        stream.read(reinterpret_cast<char*>(tile.data()), tile_bytes);
+        if (!stream) {
+            throw std::runtime_error{"tile_file: read failed " + path_.string()};
+        }
+    }
+
+    /**
+     * Writes the tile at the given tile position
+     * @param row the tile row
+     * @param column the tile column
+     * @param tile the source
+     */
+    void
+    write(std::size_t row, std::size_t column, tile_type const& tile) const
+    {
+        std::fstream stream{path_, std::ios::binary | std::ios::in | std::ios::out};
+        stream.seekp(static_cast<std::streamoff>(offset(row, column)));
+        stream.write(reinterpret_cast<char const*>(tile.data()), tile_bytes);
+        if (!stream) {
+            throw std::runtime_error{"tile_file: write failed " + path_.string()};
+        }
+    }
+
+    /**
+     * Stores the batch zone of an in-memory matrix made of whole tiles
+     * @param source the matrix
+     */
+    template <std::size_t Rows, std::size_t Columns>
+    void
+    store(matrix<Type, Rows, Columns, Batch> const& source) const
+    {
+        using source_type = matrix<Type, Rows, Columns, Batch>;
+        static_assert(source_type::rest_rows == 0 && source_type::rest_columns == 0, "Should be whole tiles!");
+        for (std::size_t i{}; i < source_type::batch_rows; i++) {
+            for (std::size_t j{}; j < source_type::batch_columns; j++) {
+                write(i, j, source.batch(i, j));
+            }
+        }
+    }
+
+    /**
+     * Loads the tiles into an in-memory matrix made of whole tiles
+     * @param destination the matrix
+     */
+    template <std::size_t Rows, std::size_t Columns>
+    void
+    load(matrix<Type, Rows, Columns, Batch>& destination) const
+    {
+        using destination_type = matrix<Type, Rows, Columns, Batch>;
+        static_assert(destination_type::rest_rows == 0 && destination_type::rest_columns == 0,
+                      "Should be whole tiles!");
+        for (std::size_t i{}; i < destination_type::batch_rows; i++) {
+            for (std::size_t j{}; j < destination_type::batch_columns; j++) {
+                read(i, j, destination.batch(i, j));
+            }
+        }
+    }
+
+private:
+    std::filesystem::path path_;
+    std::size_t           tile_rows_;
+    std::size_t           tile_columns_;
+
+    [[nodiscard]] std::size_t
+    offset(std::size_t row, std::size_t column) const
+    {
+        return (row * tile_columns_ + column) * tile_bytes;
+    }
+};
+
+/**
+ * Out-of-core product ret = a * b over tile files.
+ * The output is computed in blocks of block_rows x block_columns tiles held in memory. For every block the
+ * inner dimension is streamed in panels: block_rows x width tiles of A and width x block_columns tiles of B,
+ * so every tile read is reused across a whole row or column of the block and the total I/O is about
+ * I * J * K * (1 / block_rows + 1 / block_columns) tiles. The budget goes to the block first, then to the
+ * panel width. Two panel buffers alternate: the next panel is read asynchronously while the current one is
+ * multiplied, and every finished output block is written back asynchronously. An A panel already held by a
+ * buffer is not read again.
+ * @param a left operand, I x K tiles
+ * @param b right operand, K x J tiles
+ * @param ret the result, I x J tiles
+ * @param memory_budget bytes available for tile buffers, at least six tiles
+ * @return the number of tiles read
+ */
+template <class Type, std::size_t Batch>
+std::size_t
+ooc_mult(tile_file<Type, Batch> const& a, tile_file<Type, Batch> const& b, tile_file<Type, Batch> const& ret,
+         std::size_t memory_budget)
+{
+    using tile_type = typename tile_file<Type, Batch>::tile_type;
+    static constexpr std::size_t none{std::numeric_limits<std::size_t>::max()};
+
+    struct panel {
+        std::vector<tile_type> a_tiles;
+        std::vector<tile_type> b_tiles;
+        std::size_t            a_row{none};
+        std::size_t            a_chunk{none};
+        std::size_t            rows{};
+        std::size_t            columns{};
+        std::size_t            size{};
+        std::size_t            reads{};
+    };
+    struct step {
+        std::size_t row;
+        std::size_t column;
+        std::size_t chunk;
+    };
+
+    if ((a.tile_columns() != b.tile_rows()) || (ret.tile_rows() != a.tile_rows())
+        || (ret.tile_columns() != b.tile_columns())) {
+        throw std::invalid_argument{"ooc_mult: tile grids do not match"};
+    }
+    auto const budget_tiles = memory_budget / tile_file<Type, Batch>::tile_bytes;
+    if (budget_tiles < 6) {
+        throw std::invalid_argument{"ooc_mult: memory budget is less than six tiles"};
+    }
+    auto const inner = a.tile_columns();
+    if (inner == 0 || a.tile_rows() == 0 || b.tile_columns() == 0) {
+        return 0;
+    }
+    // The output block and its write-back copy take 2 * r * c tiles, two buffers of single tile panels
+    // 2 * (r + c): grow a square block first, then widen it along the longer output side
+    auto const fits = [budget_tiles](std::size_t rows, std::size_t columns) {
+        return 2 * rows * columns + 2 * (rows + columns) <= budget_tiles;
+    };
+    std::size_t side{1};
+    while (fits(side + 1, side + 1)) {
+        side++;
+    }
+    auto block_rows    = std::min(side, a.tile_rows());
+    auto block_columns = std::min(side, b.tile_columns());
+    while ((block_columns < b.tile_columns()) && fits(block_rows, block_columns + 1)) {
+        block_columns++;
+    }
+    while ((block_rows < a.tile_rows()) && fits(block_rows + 1, block_columns)) {
+        block_rows++;
+    }
+    auto const width = std::min(
+        inner, std::max<std::size_t>(1, (budget_tiles - 2 * block_rows * block_columns)
+                                            / (2 * (block_rows + block_columns))));
+    auto const chunks      = (inner + width - 1) / width;
+    auto const grid_rows   = (a.tile_rows() + block_rows - 1) / block_rows;
+    auto const grid_blocks = (b.tile_columns() + block_columns - 1) / block_columns;
+    auto const steps       = grid_rows * grid_blocks * chunks;
+
+    auto const step_at = [&](std::size_t index) {
+        return step{(index / chunks / grid_blocks) * block_rows, ((index / chunks) % grid_blocks) * block_columns,
+                    index % chunks};
+    };
+    auto const fetch = [&](panel& buffer, step const& where) {
+        auto const first = where.chunk * width;
+        buffer.size      = std::min(width, inner - first);
+        buffer.rows      = std::min(block_rows, a.tile_rows() - where.row);
+        buffer.columns   = std::min(block_columns, b.tile_columns() - where.column);
+        buffer.reads     = 0;
+        if ((buffer.a_row != where.row) || (buffer.a_chunk != where.chunk)) {
+            for (std::size_t i{}; i < buffer.rows; i++) {
+                for (std::size_t k{}; k < buffer.size; k++) {
+                    a.read(where.row + i, first + k, buffer.a_tiles[i * width + k]);
+                }
+            }
+            buffer.a_row   = where.row;
+            buffer.a_chunk = where.chunk;
+            buffer.reads += buffer.rows * buffer.size;
+        }
+        for (std::size_t k{}; k < buffer.size; k++) {
+            for (std::size_t j{}; j < buffer.columns; j++) {
+                b.read(first + k, where.column + j, buffer.b_tiles[k * block_columns + j]);
+            }
+        }
+        buffer.reads += buffer.size * buffer.columns;
+    };
+
+    std::array<panel, 2> buffers{};
+    for (auto& buffer : buffers) {
+        buffer.a_tiles.resize(block_rows * width);
+        buffer.b_tiles.resize(width * block_columns);
+    }
+    std::vector<tile_type> acc(block_rows * block_columns);
+    std::vector<tile_type> written(block_rows * block_columns);
+    std::size_t            reads{};
+    std::future<void>      loading = std::async(std::launch::async, fetch, std::ref(buffers[0]), step_at(0));
+    std::future<void>      writing{};
+    for (std::size_t index{}; index < steps; index++) {
+        loading.get();
+        auto& current = buffers[index % 2];
+        reads += current.reads;
+        if (index + 1 < steps) {
+            loading = std::async(std::launch::async, fetch, std::ref(buffers[(index + 1) % 2]), step_at(index + 1));
+        }
+        auto const where = step_at(index);
+        if (where.chunk == 0) {
+            for (auto& tile : acc) {
+                tile.clear();
+            }
+        }
+        for (std::size_t i{}; i < current.rows; i++) {
+            for (std::size_t j{}; j < current.columns; j++) {
+                auto& out = acc[i * block_columns + j];
+                for (std::size_t k{}; k < current.size; k++) {
+                    out = out + current.a_tiles[i * width + k] * current.b_tiles[k * block_columns + j];
+                }
+            }
+        }
+        if (where.chunk + 1 == chunks) {
+            if (writing.valid()) {
+                writing.get();
+            }
+            std::swap(acc, written);
+            writing = std::async(std::launch::async,
+                                 [&ret, &written, where, rows = current.rows, columns = current.columns,
+                                  block_columns] {
+                                     for (std::size_t i{}; i < rows; i++) {
+                                         for (std::size_t j{}; j < columns; j++) {
+                                             ret.write(where.row + i, where.column + j,
+                                                       written[i * block_columns + j]);
+                                         }
+                                     }
+                                 });
+        }
+    }
+    if (writing.valid()) {
+        writing.get();
+    }
+    return reads;
+}
+
+}    // namespace xitren::math
@@ -0,0 +1,380 @@
+#pragma once
+
+#include <xitren/math/matrix.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace xitren::math {
+
+/**
+ * Blocked Householder QR of a Rows x Columns matrix, Rows >= Columns.
+ * Panels of columns are factorized with plain reflectors and then kept in the compact WY form
+ * Q_panel = I - V * T * V^T, so applying a panel to the trailing columns, to a right hand side or to build Q
+ * is a pair of tiled GEMMs that run on the worker threads.
+ * The panel width is Batch, or the tile size matrix picks for the shape when Batch is 0.
+ * Every panel has its own compile-time shape, so the panels are unrolled by template recursion; their temporaries
+ * share one workspace sized by the first, largest panel.
+ */
+template <class Type, std::size_t Rows, std::size_t Columns, std::size_t Batch = 0>
+class qr {
+    static_assert(Rows >= Columns, "QR needs at least as many rows as columns!");
+
+    static constexpr std::size_t panel  = (Batch != 0) ? Batch : matrix<Type, Rows, Columns>::batch_value;
+    static constexpr std::size_t panels = (Columns + panel - 1) / panel;
+
+    static_assert(panel >= 2 && (panel & (panel - 1)) == 0, "Panel width Batch should be a power of 2!");
+
+public:
+    using matrix_type = matrix<Type, Rows, Columns, Batch>;
+    using r_type      = matrix<Type, Columns, Columns, Batch>;
+
+    /**
+     * Factorizes the matrix
+     * @param a the matrix to factorize
+     */
+    explicit qr(matrix_type const& a) : a_(Rows * Columns), tau_(Columns), t_(panels * panel * panel)
+    {
+        a.for_each([this](std::size_t row, std::size_t column, Type const& item) { a_[row * Columns + column] = item; });
+        workspace<Columns - width(0)> space{};
+        factor_from<0>(space);
+    }
+
+    /**
+     * Returns the upper triangular factor
+     * @param ret the Columns x Columns factor R
+     */
+    void
+    r(r_type& ret) const
+    {
+        ret.for_each([this](std::size_t row, std::size_t column, Type& item) {
+            item = (column >= row) ? a_[row * Columns + column] : Type{};
+        });
+    }
+
+    /**
+     * Returns the thin orthogonal factor, A = Q * R
+     * @param ret the Rows x Columns factor Q with orthonormal columns
+     */
+    void
+    q(matrix_type& ret) const
+    {
+        std::vector<Type> buffer(Rows * Columns);
+        for (std::size_t i{}; i < Columns; i++) {
+            buffer[i * Columns + i] = Type{1};
+        }
+        workspace<Columns> space{};
+        apply_q_from<0, Columns>(buffer.data(), Columns, space);
+        ret.for_each([&buffer](std::size_t row, std::size_t column, Type& item) { item = buffer[row * Columns + column]; });
+    }
+
+    /**
+     * Least-squares solution of A * x = b: minimizes ||A * x - b|| for every column of b
+     * @param b the right hand sides
+     * @param x the solutions
+     */
+    template <std::size_t Rhs>
+    void
+    solve(matrix<Type, Rows, Rhs, Batch> const& b, matrix<Type, Columns, Rhs, Batch>& x) const
+    {
+        std::vector<Type> buffer(Rows * Rhs);
+        b.for_each([&buffer](std::size_t row, std::size_t column, Type const& item) { buffer[row * Rhs + column] = item; });
+        // Q^T * b, then back substitution with R on its first Columns rows
+        workspace<Rhs> space{};
+        apply_qt_from<0, Rhs>(buffer.data(), Rhs, space);
+        for (std::size_t i{Columns}; i-- > 0;) {
+            Type const* r_row = &a_[i * Columns];
+            Type*       x_row = &buffer[i * Rhs];
+            for (std::size_t k{i + 1}; k < Columns; k++) {
+                Type const factor = r_row[k];
+                Type const* done  = &buffer[k * Rhs];
+                for (std::size_t j{}; j < Rhs; j++) {
+                    x_row[j] -= factor * done[j];
+                }
+            }
+            for (std::size_t j{}; j < Rhs; j++) {
+                x_row[j] /= r_row[i];
+            }
+        }
+        x.for_each([&buffer](std::size_t row, std::size_t column, Type& item) { item = buffer[row * Rhs + column]; });
+    }
+
+private:
+    std::vector<Type> a_;      // row-major, R on and above the diagonal, reflectors below it
+    std::vector<Type> tau_;    // reflector scales
+    std::vector<Type> t_;      // panel x panel upper triangular T of every panel
+
+    static constexpr std::size_t
+    width(std::size_t first)
+    {
+        return std::min(panel, Columns - first);
+    }
+
+    // Matrix types need both dimensions above one, unused padding stays zero
+    static constexpr std::size_t
+    dim(std::size_t size)
+    {
+        return std::max<std::size_t>(size, 2);
+    }
+
+    static constexpr std::size_t
+    aligned(std::size_t bytes)
+    {
+        return (bytes + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+    }
+
+    // Temporaries of apply_block for the panel starting at column First applied to N columns, and their
+    // offsets in the workspace
+    template <std::size_t First, std::size_t N>
+    struct block {
+        static constexpr auto w = width(First);
+        static constexpr auto m = Rows - First;
+
+        using v_type  = matrix<Type, dim(m), dim(w), panel>;
+        using c_type  = matrix<Type, dim(m), dim(N), panel>;
+        using ct_type = matrix<Type, dim(N), dim(m), panel>;
+        using wt_type = matrix<Type, dim(N), dim(w), panel>;
+        using w_type  = matrix<Type, dim(w), dim(N), panel>;
+
+        static constexpr std::size_t v_offset       = 0;
+        static constexpr std::size_t c_offset       = v_offset + aligned(sizeof(v_type));
+        static constexpr std::size_t ct_offset      = c_offset + aligned(sizeof(c_type));
+        static constexpr std::size_t wt_offset      = ct_offset + aligned(sizeof(ct_type));
+        static constexpr std::size_t w_offset       = wt_offset + aligned(sizeof(wt_type));
+        static constexpr std::size_t lines_offset   = w_offset + aligned(sizeof(w_type));
+        static constexpr std::size_t product_offset = lines_offset + aligned(N * w * sizeof(Type));
+        static constexpr std::size_t bytes          = product_offset + aligned(N * w * sizeof(Type));
+    };
+
+    // Raw storage of the apply_block temporaries for N columns, reused by every panel
+    template <std::size_t N>
+    class workspace {
+    public:
+        static constexpr std::size_t bytes = block<0, N>::bytes;
+
+        workspace()
+            : memory_{std::make_unique_for_overwrite<std::max_align_t[]>(bytes / sizeof(std::max_align_t) + 1)}
+        {}
+
+        // Starts the lifetime of a T at the offset, matrix types are value-initialized
+        template <class T>
+        T*
+        make(std::size_t offset)
+        {
+            static_assert(std::is_trivially_destructible_v<T>);
+            return ::new (reinterpret_cast<std::byte*>(memory_.get()) + offset) T{};
+        }
+
+        Type*
+        values(std::size_t offset)
+        {
+            return reinterpret_cast<Type*>(reinterpret_cast<std::byte*>(memory_.get()) + offset);
+        }
+
+    private:
+        std::unique_ptr<std::max_align_t[]> memory_;
+    };
+
+    // Element (row, column) of the panel reflectors V starting at column First, unit diagonal, zeros above it
+    template <std::size_t First>
+    Type
+    reflector(std::size_t row, std::size_t column) const
+    {
+        if ((row >= Rows - First) || (column >= width(First)) || (row < column)) {
+            return Type{};
+        }
+        if (row == column) {
+            return Type{1};
+        }
+        return a_[(First + row) * Columns + First + column];
+    }
+
+    template <std::size_t First, class Space>
+    void
+    factor_from(Space& space)
+    {
+        if constexpr (First < Columns) {
+            constexpr auto w = width(First);
+            factor_panel(First, w);
+            build_t(First, w);
+            if constexpr (First + w < Columns) {
+                apply_block<First, Columns - First - w>(&a_[First * Columns + First + w], Columns, true, space);
+            }
+            factor_from<First + panel>(space);
+        }
+    }
+
+    // Unblocked Householder factorization of columns [first, first + w), updates only the panel itself
+    void
+    factor_panel(std::size_t first, std::size_t w)
+    {
+        for (std::size_t j{first}; j < first + w; j++) {
+            Type const alpha = a_[j * Columns + j];
+            Type       sigma{};
+            for (std::size_t i{j + 1}; i < Rows; i++) {
+                sigma += a_[i * Columns + j] * a_[i * Columns + j];
+            }
+            if (sigma == Type{}) {
+                tau_[j] = Type{};
+                continue;
+            }
+            Type const norm  = std::sqrt(alpha * alpha + sigma);
+            Type const beta  = (alpha <= Type{}) ? norm : -norm;
+            Type const scale = Type{1} / (alpha - beta);
+            tau_[j]          = (beta - alpha) / beta;
+            for (std::size_t i{j + 1}; i < Rows; i++) {
+                a_[i * Columns + j] *= scale;
+            }
+            a_[j * Columns + j] = beta;
+            for (std::size_t c{j + 1}; c < first + w; c++) {
+                Type sum = a_[j * Columns + c];
+                for (std::size_t i{j + 1}; i < Rows; i++) {
+                    sum += a_[i * Columns + j] * a_[i * Columns + c];
+                }
+                sum *= tau_[j];
+                a_[j * Columns + c] -= sum;
+                for (std::size_t i{j + 1}; i < Rows; i++) {
+                    a_[i * Columns + c] -= sum * a_[i * Columns + j];
+                }
+            }
+        }
+    }
+
+    // Forward column by column construction of T, so that H_1 * ... * H_w = I - V * T * V^T
+    void
+    build_t(std::size_t first, std::size_t w)
+    {
+        Type*             t = &t_[(first / panel) * panel * panel];
+        std::vector<Type> z(w);
+        for (std::size_t i{}; i < w; i++) {
+            auto const column = first + i;
+            // z = V(:, 0:i)^T * v_i, v_i is zero above its unit diagonal
+            for (std::size_t r{}; r < i; r++) {
+                auto const other = first + r;
+                Type       sum   = a_[column * Columns + other];
+                for (std::size_t row{column + 1}; row < Rows; row++) {
+                    sum += a_[row * Columns + other] * a_[row * Columns + column];
+                }
+                z[r] = sum;
+            }
+            for (std::size_t r{}; r < i; r++) {
+                Type sum{};
+                for (std::size_t k{r}; k < i; k++) {
+                    sum += t[r * panel + k] * z[k];
+                }
+                t[r * panel + i] = -tau_[column] * sum;
+            }
+            t[i * panel + i] = tau_[column];
+        }
+    }
+
+    // Applies panels in factorization order: c = Q^T * c
+    template <std::size_t First, std::size_t N, class Space>
+    void
+    apply_qt_from(Type* c, std::size_t ldc, Space& space) const
+    {
+        if constexpr (First < Columns) {
+            apply_block<First, N>(c + First * ldc, ldc, true, space);
+            apply_qt_from<First + panel, N>(c, ldc, space);
+        }
+    }
+
+    // Applies panels in reverse order: c = Q * c
+    template <std::size_t First, std::size_t N, class Space>
+    void
+    apply_q_from(Type* c, std::size_t ldc, Space& space) const
+    {
+        if constexpr (First < Columns) {
+            apply_q_from<First + panel, N>(c, ldc, space);
+            apply_block<First, N>(c + First * ldc, ldc, false, space);
+        }
+    }
+
+    /**
+     * Applies the panel starting at column First to the (Rows - First) x N row-major block c:
+     * c = c - V * op(T) * (V^T * c), op(T) = T^T for Q^T and T for Q.
+     * V^T * c is computed as c^T * V, so both GEMMs have many tile rows to spread over the threads.
+     * The temporaries live in the workspace, later panels are smaller than the first one it is sized by.
+     */
+    template <std::size_t First, std::size_t N, class Space>
+    void
+    apply_block(Type* c, std::size_t ldc, bool transpose, Space& space) const
+    {
+        using layout = block<First, N>;
+        static_assert(layout::bytes <= Space::bytes, "Later panels should fit the first panel workspace!");
+        constexpr auto w = layout::w;
+        constexpr auto m = layout::m;
+
+        auto* v       = space.template make<typename layout::v_type>(layout::v_offset);
+        auto* cm      = space.template make<typename layout::c_type>(layout::c_offset);
+        auto* ct      = space.template make<typename layout::ct_type>(layout::ct_offset);
+        auto* wt      = space.template make<typename layout::wt_type>(layout::wt_offset);
+        auto* wm      = space.template make<typename layout::w_type>(layout::w_offset);
+        Type* lines   = space.values(layout::lines_offset);
+        Type* product = space.values(layout::product_offset);
+        v->for_each([this](std::size_t row, std::size_t column, Type& item) { item = reflector<First>(row, column); });
+        cm->for_each([&](std::size_t row, std::size_t column, Type& item) {
+            item = ((row < m) && (column < N)) ? c[row * ldc + column] : Type{};
+        });
+        ct->for_each([&](std::size_t row, std::size_t column, Type& item) {
+            item = ((row < N) && (column < m)) ? c[column * ldc + row] : Type{};
+        });
+        ct->mult(*v, *wt);
+
+        // wm = op(T) * wt^T
+        Type const* t = &t_[(First / panel) * panel * panel];
+        wt->for_each([&](std::size_t row, std::size_t column, Type const& item) {
+            if ((row < N) && (column < w)) {
+                lines[row * w + column] = item;
+            }
+        });
+        for (std::size_t j{}; j < N; j++) {
+            Type const* line = &lines[j * w];
+            for (std::size_t i{}; i < w; i++) {
+                Type sum{};
+                if (transpose) {
+                    for (std::size_t k{}; k <= i; k++) {
+                        sum += t[k * panel + i] * line[k];
+                    }
+                } else {
+                    for (std::size_t k{i}; k < w; k++) {
+                        sum += t[i * panel + k] * line[k];
+                    }
+                }
+                product[i * N + j] = sum;
+            }
+        }
+        wm->for_each([&](std::size_t row, std::size_t column, Type& item) {
+            item = ((row < w) && (column < N)) ? product[row * N + column] : Type{};
+        });
+
+        v->gemm(Type{-1}, *wm, Type{1}, *cm);
+        cm->for_each([&](std::size_t row, std::size_t column, Type const& item) {
+            if ((row < m) && (column < N)) {
+                c[row * ldc + column] = item;
+            }
+        });
+    }
+};
+
+/**
+ * Least-squares solution of A * x = b through the blocked Householder QR
+ * @param a the Rows x Columns system matrix, Rows >= Columns and full column rank
+ * @param b the right hand sides
+ * @param x the solutions minimizing ||A * x - b||
+ */
+template <class Type, std::size_t Rows, std::size_t Columns, std::size_t Rhs, std::size_t Batch>
+void
+lstsq(matrix<Type, Rows, Columns, Batch> const& a, matrix<Type, Rows, Rhs, Batch> const& b,
+      matrix<Type, Columns, Rhs, Batch>& x)
+{
+    qr<Type, Rows, Columns, Batch> const factor{a};
+    factor.solve(b, x);
+}
+
+}    // namespace xitren::math
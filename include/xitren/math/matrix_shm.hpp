@@ -0,0 +1,378 @@
+#pragma once
+
+#include <xitren/math/matrix.hpp>
+#include <xitren/math/matrix_memory.hpp>
+
+#if defined(__unix__)
+
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace xitren::math {
+
+/**
+ * A named POSIX shared memory segment mapped into this process, children created by fork share the mapping.
+ * The segment is unlinked and unmapped when the owner goes away.
+ */
+class shared_segment {
+public:
+    /**
+     * Creates and maps a zero filled segment, pages are placed by the process that touches them first
+     * @param bytes the segment size
+     */
+    explicit shared_segment(std::size_t bytes) : name_{unique_name()}, size_{bytes}
+    {
+        auto const fd = ::shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) {
+            throw std::system_error{errno, std::generic_category(), "shm_open " + name_};
+        }
+        if (::ftruncate(fd, static_cast<off_t>(size_)) != 0) {
+            auto const error = errno;
+            ::close(fd);
+            ::shm_unlink(name_.c_str());
+            throw std::system_error{error, std::generic_category(), "ftruncate " + name_};
+        }
+        data_ = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        auto const error = errno;
+        ::close(fd);
+        if (data_ == MAP_FAILED) {
+            ::shm_unlink(name_.c_str());
+            throw std::system_error{error, std::generic_category(), "mmap " + name_};
+        }
+    }
+
+    shared_segment(shared_segment const&) = delete;
+    shared_segment&
+    operator=(shared_segment const&)
+        = delete;
+
+    ~shared_segment()
+    {
+        ::munmap(data_, size_);
+        ::shm_unlink(name_.c_str());
+    }
+
+    [[nodiscard]] void*
+    data() const
+    {
+        return data_;
+    }
+
+    [[nodiscard]] std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    [[nodiscard]] std::string const&
+    name() const
+    {
+        return name_;
+    }
+
+private:
+    std::string name_;
+    std::size_t size_;
+    void*       data_{};
+
+    static std::string
+    unique_name()
+    {
+        static std::atomic<std::size_t> counter{};
+        return "/xitren_math_" + std::to_string(::getpid()) + "_" + std::to_string(counter++);
+    }
+};
+
+namespace detail {
+
+/**
+ * Tells whether the calling process runs a single thread. fork() copies only the calling thread, so a child of a
+ * multi-threaded process can find malloc or a static guard locked forever.
+ * @return true when no other thread exists, false when there are others or it can not be told
+ */
+inline bool
+single_threaded()
+{
+#if defined(__linux__)
+    std::error_code error;
+    std::size_t     threads{};
+    for (std::filesystem::directory_iterator it{"/proc/self/task", error}, end{}; !error && (it != end);
+         it.increment(error)) {
+        threads++;
+    }
+    return !error && (threads == 1);
+#else
+    return true;
+#endif
+}
+
+#if defined(__linux__)
+/**
+ * Picks a CPU for every worker: workers go round robin over the memory nodes, and within a node over its CPUs
+ * the process may run on, so consecutive bands land on different nodes
+ * @param workers the number of workers
+ * @return the CPU of every worker, empty when the allowed CPUs can not be read
+ */
+inline std::vector<int>
+worker_cpus(std::size_t workers)
+{
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (::sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return {};
+    }
+    std::vector<std::vector<int>> groups;
+    for (auto node : numa_nodes()) {
+        std::vector<int> cpus;
+        for (auto cpu : numa_cpus(node)) {
+            if ((cpu < CPU_SETSIZE) && CPU_ISSET(cpu, &allowed)) {
+                cpus.push_back(cpu);
+            }
+        }
+        if (!cpus.empty()) {
+            groups.push_back(std::move(cpus));
+        }
+    }
+    if (groups.empty()) {
+        // NUMA is not exposed, a single group of all allowed CPUs
+        std::vector<int> cpus;
+        for (int cpu{}; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &allowed)) {
+                cpus.push_back(cpu);
+            }
+        }
+        if (cpus.empty()) {
+            return {};
+        }
+        groups.push_back(std::move(cpus));
+    }
+    std::vector<int> ret(workers);
+    for (std::size_t w{}; w < workers; w++) {
+        auto const& cpus = groups[w % groups.size()];
+        ret[w]           = cpus[(w / groups.size()) % cpus.size()];
+    }
+    return ret;
+}
+
+inline void
+pin_to(int cpu)
+{
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    ::sched_setaffinity(0, sizeof(cpus), &cpus);
+}
+#endif
+
+}    // namespace detail
+
+/**
+ * Multi-process product ret = a * b over a shared memory segment.
+ * The operands are copied into the segment in the tiled layout and every process owns a contiguous band of
+ * output tile rows. Workers are pinned round robin over the memory nodes, and each one places its band of a and
+ * of ret by first touch, so on NUMA machines the band lives in the memory of the node that computes it. Tile rows
+ * are handed out by per-band atomic cursors in the segment, and a process that finishes its band steals tile
+ * rows from the others.
+ * The calling process is worker 0 and computes the rest zones at the end. It places the band of any worker that
+ * could not start or died before placing its band, and the others then compute that band.
+ * Workers are forked, which is only safe without other threads: when the calling process runs other threads,
+ * the whole product is computed in the calling process.
+ * @param a left hand operand
+ * @param b right hand operand
+ * @param ret the result
+ * @param processes the number of processes, including the calling one
+ */
+template <class Type, std::size_t Rows, std::size_t Columns, std::size_t ColumnsOther, std::size_t Batch>
+void
+shm_mult(matrix<Type, Rows, Columns, Batch> const& a, matrix<Type, Columns, ColumnsOther, Batch> const& b,
+         matrix<Type, Rows, ColumnsOther, Batch>& ret, std::size_t processes)
+{
+    using a_type   = matrix<Type, Rows, Columns, Batch>;
+    using b_type   = matrix<Type, Columns, ColumnsOther, Batch>;
+    using ret_type = matrix<Type, Rows, ColumnsOther, Batch>;
+    static_assert(std::is_trivially_copyable_v<a_type> && std::is_trivially_copyable_v<b_type>
+                      && std::is_trivially_copyable_v<ret_type>,
+                  "Matrices are placed in shared memory byte by byte!");
+    static_assert(std::atomic<std::size_t>::is_always_lock_free, "Cursors are shared between processes!");
+
+    struct alignas(64) band {
+        std::atomic<std::size_t> next;
+        std::atomic<std::size_t> placed;
+        std::size_t              end;
+    };
+    struct header {
+        std::atomic<std::size_t> released;
+    };
+
+    constexpr auto tile_rows = ret_type::batch_rows;
+    processes                = std::clamp<std::size_t>(processes, 1, std::max<std::size_t>(tile_rows, 1));
+    if (!detail::single_threaded()) {
+        processes = 1;
+    }
+
+    auto const page    = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    auto const aligned = [page](std::size_t bytes) { return (bytes + page - 1) / page * page; };
+    auto const offset_bands = aligned(sizeof(header));
+    auto const offset_a     = offset_bands + aligned(processes * sizeof(band));
+    auto const offset_b     = offset_a + aligned(sizeof(a_type));
+    auto const offset_ret   = offset_b + aligned(sizeof(b_type));
+    shared_segment segment{offset_ret + aligned(sizeof(ret_type))};
+
+    auto* base   = static_cast<std::byte*>(segment.data());
+    auto* state  = new (base) header{};
+    auto* bands  = reinterpret_cast<band*>(base + offset_bands);
+    auto* shared_a   = new (base + offset_a) a_type;
+    auto* shared_b   = new (base + offset_b) b_type;
+    auto* shared_ret = new (base + offset_ret) ret_type;
+    for (std::size_t w{}; w < processes; w++) {
+        auto* item = new (bands + w) band{};
+        item->next = w * tile_rows / processes;
+        item->end  = (w + 1) * tile_rows / processes;
+    }
+
+    // b is read by every worker and the rest zones of a by the final pass, both are placed here
+    *shared_b = b;
+    a.for_each([shared_a](std::size_t row, std::size_t column, Type const& item) {
+        if ((row >= a_type::batch_rows_end) || (column >= a_type::batch_columns_end)) {
+            shared_a->get(row, column) = item;
+        }
+    });
+    auto const place = [&](std::size_t w) {
+        for (std::size_t i{w * tile_rows / processes}; i < (w + 1) * tile_rows / processes; i++) {
+            for (std::size_t j{}; j < a_type::batch_columns; j++) {
+                shared_a->batch(i, j) = a.batch(i, j);
+            }
+            for (std::size_t j{}; j < ret_type::batch_columns; j++) {
+                shared_ret->batch(i, j).clear();
+            }
+        }
+        bands[w].placed.store(1);
+    };
+    auto const compute = [&](std::size_t w) {
+        for (std::size_t k{}; k < processes; k++) {
+            auto& item = bands[(w + k) % processes];
+            for (auto i = item.next.fetch_add(1); i < item.end; i = item.next.fetch_add(1)) {
+                shared_a->gemm_tiles(Type{1}, *shared_b, Type{0}, *shared_ret, i, i + 1);
+            }
+        }
+    };
+
+#if defined(__linux__)
+    auto const cpus = (processes > 1) ? detail::worker_cpus(processes) : std::vector<int>{};
+#endif
+    std::vector<pid_t> children(processes);
+    for (std::size_t w{1}; w < processes; w++) {
+        auto const pid = ::fork();
+        if (pid == 0) {
+            try {
+#if defined(__linux__)
+                if (!cpus.empty()) {
+                    detail::pin_to(cpus[w]);
+                }
+#endif
+                place(w);
+                while (state->released.load() == 0) {
+                    std::this_thread::yield();
+                }
+                compute(w);
+            } catch (...) {
+                ::_exit(1);
+            }
+            ::_exit(0);
+        }
+        if (pid < 0) {
+            // The band of a worker that could not start is placed here and computed by the others
+            place(w);
+            continue;
+        }
+        children[w] = pid;
+    }
+
+#if defined(__linux__)
+    cpu_set_t  previous;
+    bool const pinned = !cpus.empty() && (::sched_getaffinity(0, sizeof(previous), &previous) == 0);
+    if (pinned) {
+        detail::pin_to(cpus[0]);
+    }
+#endif
+    place(0);
+    // Every band is placed before any tile row is computed. A child that dies before placing its band is reaped
+    // here and its band placed by this process instead, so nobody waits for it.
+    for (bool waiting{true}; waiting;) {
+        waiting = false;
+        for (std::size_t w{1}; w < processes; w++) {
+            if (bands[w].placed.load() != 0) {
+                continue;
+            }
+            waiting = true;
+            int        status{};
+            auto const reaped = ::waitpid(children[w], &status, WNOHANG);
+            if ((reaped == children[w]) || ((reaped < 0) && (errno != EINTR))) {
+                children[w] = 0;
+                place(w);
+            }
+        }
+        if (waiting) {
+            std::this_thread::yield();
+        }
+    }
+    state->released.store(1);
+
+    std::exception_ptr error{};
+    try {
+        compute(0);
+    } catch (...) {
+        error = std::current_exception();
+    }
+#if defined(__linux__)
+    if (pinned) {
+        ::sched_setaffinity(0, sizeof(previous), &previous);
+    }
+#endif
+
+    // A child that fails after the release may have taken tile rows it never computed
+    bool failed{};
+    for (auto pid : children) {
+        if (pid <= 0) {
+            continue;
+        }
+        int status{};
+        while (::waitpid(pid, &status, 0) < 0) {
+            if (errno != EINTR) {
+                failed = true;
+                break;
+            }
+        }
+        failed |= !WIFEXITED(status) || (WEXITSTATUS(status) != 0);
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    if (failed) {
+        throw std::runtime_error{"shm_mult: a worker process failed"};
+    }
+    shared_a->gemm_rest(Type{1}, *shared_b, Type{0}, *shared_ret);
+    ret = *shared_ret;
+}
+
+}    // namespace xitren::math
+
+#endif
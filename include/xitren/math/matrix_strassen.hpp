@@ -1,17 +1,148 @@
 #pragma once
 
-#include <xitren/math/branchless.hpp>
+#include <xitren/math/random.hpp>
+#include <xitren/math/semiring.hpp>
+#include <xitren/math/tuning.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstdint>
-#include <cstdlib>
 #include <cstring>
-#include <ctime>
+#include <utility>
 #include <vector>
 
 namespace xitren::math {
 
+/**
+ * Spreads the lower 32 bits of the value to the even bit positions
+ * @param value the value to spread
+ * @return the spread value
+ */
+static constexpr std::uint64_t
+morton_spread(std::uint64_t value)
+{
+    value &= 0x00000000ffffffffULL;
+    value = (value | (value << 16)) & 0x0000ffff0000ffffULL;
+    value = (value | (value << 8)) & 0x00ff00ff00ff00ffULL;
+    value = (value | (value << 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    value = (value | (value << 2)) & 0x3333333333333333ULL;
+    value = (value | (value << 1)) & 0x5555555555555555ULL;
+    return value;
+}
+
+/**
+ * Gathers the even bit positions of the value back into the lower 32 bits
+ * @param value the value to compact
+ * @return the compacted value
+ */
+static constexpr std::uint64_t
+morton_compact(std::uint64_t value)
+{
+    value &= 0x5555555555555555ULL;
+    value = (value | (value >> 1)) & 0x3333333333333333ULL;
+    value = (value | (value >> 2)) & 0x0f0f0f0f0f0f0f0fULL;
+    value = (value | (value >> 4)) & 0x00ff00ff00ff00ffULL;
+    value = (value | (value >> 8)) & 0x0000ffff0000ffffULL;
+    value = (value | (value >> 16)) & 0x00000000ffffffffULL;
+    return value;
+}
+
+/**
+ * Converts a (row, column) position to the Z-order index used by the recursive quadrant layout
+ * @param row the row
+ * @param column the column
+ * @return the linear storage index
+ */
+static constexpr std::size_t
+morton_index(std::size_t row, std::size_t column)
+{
+    return static_cast<std::size_t>((morton_spread(row) << 1) | morton_spread(column));
+}
+
+/**
+ * Converts a Z-order storage index back to its (row, column) position
+ * @param index the linear storage index
+ * @return the row and the column
+ */
+static constexpr std::pair<std::size_t, std::size_t>
+morton_position(std::size_t index)
+{
+    return {static_cast<std::size_t>(morton_compact(index >> 1)), static_cast<std::size_t>(morton_compact(index))};
+}
+
+/**
+ * Classical micro-kernel: rows [row, row + Rows) of c = c + a * b for square row-major operands, in the given semiring.
+ * Every loaded row of b is shared by Rows rows of the result, the inner loop runs along contiguous rows.
+ */
+template <class Type, std::size_t Rows, class Semiring>
+static inline void
+classic_kernel(std::size_t size, Type const* a, Type const* b, Type* c, std::size_t row)
+{
+    Type* out = c + row * size;
+    for (std::size_t k{}; k < size; k++) {
+        std::array<Type, Rows> factor;
+        for (std::size_t r{}; r < Rows; r++) {
+            factor[r] = a[(row + r) * size + k];
+        }
+        Type const* b_row = b + k * size;
+        for (std::size_t j{}; j < size; j++) {
+            for (std::size_t r{}; r < Rows; r++) {
+                out[r * size + j] = Semiring::add(out[r * size + j], Semiring::mul(factor[r], b_row[j]));
+            }
+        }
+    }
+}
+
+template <class Type, std::size_t Rows, class Semiring>
+static inline std::size_t
+classic_rows(std::size_t size, Type const* a, Type const* b, Type* c, std::size_t row)
+{
+    for (; row + Rows <= size; row += Rows) {
+        classic_kernel<Type, Rows, Semiring>(size, a, b, c, row);
+    }
+    return row;
+}
+
+/**
+ * Classical accumulating product c = c + a * b of square row-major operands in the given semiring
+ * @param size the matrix size
+ * @param kernel_rows the micro-kernel rows: 1, 2, 4 or 8
+ */
+template <class Type, class Semiring = plus_times<Type>>
+static inline void
+classic_mult_add(std::size_t size, Type const* a, Type const* b, Type* c, std::size_t kernel_rows)
+{
+    std::size_t row{};
+    switch (kernel_rows) {
+    case 8:
+        row = classic_rows<Type, 8, Semiring>(size, a, b, c, row);
+        break;
+    case 4:
+        row = classic_rows<Type, 4, Semiring>(size, a, b, c, row);
+        break;
+    case 2:
+        row = classic_rows<Type, 2, Semiring>(size, a, b, c, row);
+        break;
+    default:
+        break;
+    }
+    classic_rows<Type, 1, Semiring>(size, a, b, c, row);
+}
+
+/**
+ * Classical product c = a * b of square row-major operands in the given semiring
+ * @param size the matrix size
+ * @param kernel_rows the micro-kernel rows: 1, 2, 4 or 8
+ */
+template <class Type, class Semiring = plus_times<Type>>
+static inline void
+classic_mult(std::size_t size, Type const* a, Type const* b, Type* c, std::size_t kernel_rows)
+{
+    std::fill(c, c + size * size, Semiring::zero());
+    classic_mult_add<Type, Semiring>(size, a, b, c, kernel_rows);
+}
+
 template <class Type, std::size_t Size>
 class matrix_strassen {
     static_assert((Size & (Size - 1)) == 0, "Should be power of 2!");
@@ -22,23 +153,114 @@ public:
     using quarter_data_type = std::array<Type, Size * Size / 4>;
 
     matrix_strassen() = default;
-    matrix_strassen(data_type const& data)
-        : a_{get_init(data, 0)}, b_{get_init(data, 1)}, c_{get_init(data, 2)}, d_{get_init(data, 3)}
-    {}
+    matrix_strassen(data_type const& data) { from_row_major(data.data()); }
 
-    inline auto&
+    inline Type&
     get(std::size_t row, std::size_t column)
     {
-        auto const half_size = Size >> 1;
-        auto&      sel1      = branchless_select(column < half_size, a_, b_);
-        auto&      sel2      = branchless_select(column < half_size, c_, d_);
-        auto&      sel_f     = branchless_select(row < half_size, sel1, sel2);
-        return sel_f.get(row % half_size, column % half_size);
+        return data()[morton_index(row, column)];
+    }
+
+    inline Type const&
+    get(std::size_t row, std::size_t column) const
+    {
+        return data()[morton_index(row, column)];
+    }
+
+    /**
+     * Returns the elements in storage (Z-order) sequence, see morton_index
+     * @return pointer to the first of Size * Size contiguous elements
+     */
+    inline Type*
+    data()
+    {
+        static_assert(sizeof(matrix_strassen) == sizeof(Type) * Size * Size, "Quadrants should be dense!");
+        return a_.data();
+    }
+
+    inline Type const*
+    data() const
+    {
+        return a_.data();
+    }
+
+    static constexpr std::size_t
+    size()
+    {
+        return Size * Size;
+    }
+
+    inline Type*
+    begin()
+    {
+        return data();
+    }
+
+    inline Type*
+    end()
+    {
+        return data() + size();
+    }
+
+    inline Type const*
+    begin() const
+    {
+        return data();
+    }
+
+    inline Type const*
+    end() const
+    {
+        return data() + size();
+    }
+
+    /**
+     * Serializes the matrix in row-major order with one sequential pass over the storage
+     * @return the row-major elements
+     */
+    data_type
+    row_major() const
+    {
+        data_type ret;
+        to_row_major(ret.data());
+        return ret;
+    }
+
+    /**
+     * Writes the matrix in row-major order into Size * Size elements
+     * @param out the destination
+     */
+    void
+    to_row_major(Type* out) const
+    {
+        auto const* ptr = data();
+        for (std::size_t i{}; i < Size * Size; i++) {
+            auto const [row, column] = morton_position(i);
+            out[row * Size + column] = ptr[i];
+        }
+    }
+
+    /**
+     * Reads the matrix from Size * Size row-major elements
+     * @param in the source
+     */
+    void
+    from_row_major(Type const* in)
+    {
+        auto* ptr = data();
+        for (std::size_t i{}; i < Size * Size; i++) {
+            auto const [row, column] = morton_position(i);
+            ptr[i]                   = in[row * Size + column];
+        }
     }
 
     inline void
     mult(matrix_strassen const& other, matrix_strassen& ret)
     {
+        if (Size <= tuning::current().strassen_cutoff) {
+            classic(other, ret);
+            return;
+        }
         auto const H1 = (a_ + d_) * (other.a_ + other.d_);
         auto const H2 = (c_ + d_) * other.a_;
         auto const H3 = a_ * (other.b_ - other.d_);
@@ -73,6 +295,11 @@ public:
     inline matrix_strassen
     operator*(matrix_strassen const& other) const
     {
+        if (Size <= tuning::current().strassen_cutoff) {
+            matrix_strassen ret;
+            classic(other, ret);
+            return ret;
+        }
         auto const H1 = (a_ + d_) * (other.a_ + other.d_);
         auto const H2 = (c_ + d_) * other.a_;
         auto const H3 = a_ * (other.b_ - other.d_);
@@ -92,27 +319,58 @@ public:
     matrix_strassen inline
     operator-(matrix_strassen const& other) const
     {
-        return matrix_strassen{a_ + other.a_, b_ + other.b_, c_ + other.c_, d_ + other.d_};
+        return matrix_strassen{a_ - other.a_, b_ - other.b_, c_ - other.c_, d_ - other.d_};
     }
 
     void
     clear()
     {
-        a_.clear();
-        b_.clear();
-        c_.clear();
-        d_.clear();
+        std::fill(begin(), end(), Type{});
     }
 
     static matrix_strassen
     get_rand_matrix()
     {
-        std::srand(std::time({}));    // use current time as seed for random generator
-        data_type data_rand;
-        for (auto it{data_rand.begin()}; it != data_rand.end(); it++) {
-            (*it) = static_cast<Type>(std::rand());
-        }
-        return matrix_strassen{data_rand};
+        return get_rand_matrix(counter_random::seed());
+    }
+
+    /**
+     * Creates a reproducible random matrix, element (row, column) is the position row * Size + column
+     * of the counter_random stream
+     * @param seed the stream seed
+     * @return the random matrix
+     */
+    static matrix_strassen
+    get_rand_matrix(std::uint64_t seed)
+    {
+        matrix_strassen ret;
+        auto*           ptr = ret.data();
+        parallel_for(size(), counter_random::grain, [ptr, seed](std::size_t begin, std::size_t end) {
+            for (std::size_t i{begin}; i < end; i++) {
+                auto const [row, column] = morton_position(i);
+                ptr[i]                   = counter_random::value<Type>(seed, row * Size + column);
+            }
+        });
+        return ret;
+    }
+
+    /**
+     * Classical product through row-major copies, used below the Strassen cutoff
+     * @param other right hand operand
+     * @param ret the result
+     */
+    void
+    classic(matrix_strassen const& other, matrix_strassen& ret) const
+    {
+        thread_local std::vector<Type> buffer;
+        buffer.resize(3 * Size * Size);
+        Type* a = buffer.data();
+        Type* b = a + Size * Size;
+        Type* c = b + Size * Size;
+        to_row_major(a);
+        other.to_row_major(b);
+        classic_mult(Size, a, b, c, tuning::current().kernel_rows);
+        ret.from_row_major(c);
     }
 
 private:
@@ -124,35 +382,6 @@ private:
     matrix_strassen(quarter_type const& m_a, quarter_type const& m_b, quarter_type const& m_c, quarter_type const& m_d)
         : a_{std::move(m_a)}, b_{std::move(m_b)}, c_{std::move(m_c)}, d_{std::move(m_d)}
     {}
-
-    static constexpr quarter_data_type
-    get_init(data_type const& data, std::size_t k)
-    {
-        quarter_data_type ret;
-        std::size_t       x{};
-        std::size_t       y{};
-        std::size_t       j{};
-        switch (k) {
-        case 1:
-            x = Size / 2;
-            break;
-        case 2:
-            y = Size / 2;
-            break;
-        case 3:
-            x = Size / 2;
-            y = Size / 2;
-            break;
-        default:
-            break;
-        }
-        for (std::size_t l{}; l < (Size / 2); l++) {
-            for (std::size_t m{}; m < (Size / 2); m++) {
-                ret[j++] = data[(l + y) * Size + m + x];
-            }
-        }
-        return ret;
-    }
 };
 
 template <class Type>
@@ -170,6 +399,38 @@ public:
         return data_type::operator[]((row << 1) + column);
     }
 
+    auto const&
+    get(std::size_t row, std::size_t column) const
+    {
+        return data_type::operator[]((row << 1) + column);
+    }
+
+    data_type
+    row_major() const
+    {
+        return *this;
+    }
+
+    /**
+     * Writes the matrix in row-major order into 4 elements, the 2x2 Morton order is row-major already
+     * @param out the destination
+     */
+    void
+    to_row_major(Type* out) const
+    {
+        std::copy_n(data_type::data(), data_type::size(), out);
+    }
+
+    /**
+     * Reads the matrix from 4 row-major elements
+     * @param in the source
+     */
+    void
+    from_row_major(Type const* in)
+    {
+        std::copy_n(in, data_type::size(), data_type::data());
+    }
+
     void
     clear()
     {
@@ -257,12 +518,17 @@ public:
     static matrix_strassen
     get_rand_matrix()
     {
-        std::srand(std::time({}));    // use current time as seed for random generator
-        data_type data_rand;
-        for (auto it{data_rand.begin()}; it != data_rand.end(); it++) {
-            (*it) = static_cast<Type>(std::rand());
+        return get_rand_matrix(counter_random::seed());
+    }
+
+    static matrix_strassen
+    get_rand_matrix(std::uint64_t seed)
+    {
+        matrix_strassen ret;
+        for (std::size_t i{}; i < ret.size(); i++) {
+            ret[i] = counter_random::value<Type>(seed, i);
         }
-        return matrix_strassen{data_rand};
+        return ret;
     }
 
 private:
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <xitren/math/matrix.hpp>
+#include <xitren/math/matrix_qr.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace xitren::math {
+
+/**
+ * Randomized truncated SVD (Halko, Martinsson, Tropp): A ~ U * diag(values) * V^T with Rank singular triplets.
+ * A random sketch of Rank + Oversampling columns captures the range of A, power iterations sharpen it, and the
+ * small projected problem B is solved exactly by a QR of B^T and a one-sided Jacobi SVD of R, so singular values
+ * far below sqrt(eps) * sigma_max keep their accuracy. A is read in 2 + 2 * power_iterations GEMM passes, all other work
+ * scales with the sketch width.
+ */
+template <class Type, std::size_t Rows, std::size_t Columns, std::size_t Rank, std::size_t Batch = 32,
+          std::size_t Oversampling = 8>
+class truncated_svd {
+    static constexpr std::size_t sketch = std::min(Rank + Oversampling, std::min(Rows, Columns));
+
+    static_assert(Rank >= 2 && Rank <= sketch, "Rank should be within the matrix size!");
+
+public:
+    using matrix_type = matrix<Type, Rows, Columns, Batch>;
+    using u_type      = matrix<Type, Rows, Rank, Batch>;
+    using v_type      = matrix<Type, Columns, Rank, Batch>;
+
+    /**
+     * Computes the decomposition
+     * @param a the matrix
+     * @param power_iterations the number of A * A^T passes, more of them help when the spectrum decays slowly
+     * @param seed the seed of the random sketch
+     */
+    explicit truncated_svd(matrix_type const& a, std::size_t power_iterations = 2, std::uint64_t seed = 1)
+        : values_(Rank), u_{std::make_unique<u_type>()}, v_{std::make_unique<v_type>()}
+    {
+        using range_type  = matrix<Type, Rows, sketch, Batch>;
+        using rt_type     = matrix<Type, sketch, Rows, Batch>;
+        using cospan_type = matrix<Type, Columns, sketch, Batch>;
+        using b_type      = matrix<Type, sketch, Columns, Batch>;
+        using small_type  = matrix<Type, sketch, sketch, Batch>;
+
+        auto omega = std::make_unique<cospan_type>(cospan_type::get_rand_matrix(seed));
+        omega->for_each([](std::size_t, std::size_t, Type& item) { item -= Type{1} / Type{2}; });
+        auto range = std::make_unique<range_type>();
+        auto rt    = std::make_unique<rt_type>();
+        auto b     = std::make_unique<b_type>();
+        a.mult(*omega, *range);
+        for (std::size_t i{}; i < power_iterations; i++) {
+            // range = A * orth(A^T * orth(range)), A^T * Q is computed as (Q^T * A)^T
+            orthonormalize(*range);
+            range->transpose(*rt);
+            rt->mult(a, *b);
+            b->transpose(*omega);
+            orthonormalize(*omega);
+            a.mult(*omega, *range);
+        }
+        orthonormalize(*range);
+        range->transpose(*rt);
+        rt->mult(a, *b);
+
+        // B^T = Q * R and R = X * S * Y^T by one-sided Jacobi, so B = Y * S * (Q * X)^T without forming B * B^T:
+        // U = range * Y and V = Q * X keep the accuracy of the small singular values
+        auto bt = std::make_unique<cospan_type>();
+        auto r  = std::make_unique<small_type>();
+        b->transpose(*bt);
+        {
+            qr<Type, Columns, sketch, Batch> const factor{*bt};
+            factor.q(*bt);
+            factor.r(*r);
+        }
+        std::vector<Type> x(sketch * sketch);
+        std::vector<Type> y(sketch * sketch);
+        r->for_each([&x](std::size_t row, std::size_t column, Type const& item) { x[column * sketch + row] = item; });
+        jacobi(x.data(), y.data());
+
+        std::vector<Type> sigma(sketch);
+        for (std::size_t j{}; j < sketch; j++) {
+            Type norm{};
+            for (std::size_t i{}; i < sketch; i++) {
+                norm += x[j * sketch + i] * x[j * sketch + i];
+            }
+            sigma[j] = std::sqrt(norm);
+        }
+        std::vector<std::size_t> order(sketch);
+        std::iota(order.begin(), order.end(), std::size_t{});
+        std::sort(order.begin(), order.end(), [&sigma](std::size_t l, std::size_t r) { return sigma[l] > sigma[r]; });
+        for (std::size_t i{}; i < Rank; i++) {
+            values_[i] = sigma[order[i]];
+        }
+
+        auto left  = std::make_unique<small_type>();
+        auto right = std::make_unique<small_type>();
+        left->for_each([&](std::size_t row, std::size_t column, Type& item) { item = y[order[column] * sketch + row]; });
+        right->for_each([&](std::size_t row, std::size_t column, Type& item) {
+            auto const index = order[column];
+            item = (sigma[index] > Type{}) ? x[index * sketch + row] / sigma[index] : Type{};
+        });
+        auto u_full = std::make_unique<range_type>();
+        auto v_full = std::make_unique<cospan_type>();
+        range->mult(*left, *u_full);
+        bt->mult(*right, *v_full);
+        // The leading Rank columns go through row-major gathers, both sides in one sequential storage pass each
+        std::vector<Type> u_rows(Rows * sketch);
+        std::vector<Type> v_rows(Columns * sketch);
+        u_full->for_each(
+            [&u_rows](std::size_t row, std::size_t column, Type const& item) { u_rows[row * sketch + column] = item; });
+        v_full->for_each(
+            [&v_rows](std::size_t row, std::size_t column, Type const& item) { v_rows[row * sketch + column] = item; });
+        u_->for_each(
+            [&u_rows](std::size_t row, std::size_t column, Type& item) { item = u_rows[row * sketch + column]; });
+        v_->for_each(
+            [&v_rows](std::size_t row, std::size_t column, Type& item) { item = v_rows[row * sketch + column]; });
+    }
+
+    /**
+     * Returns the singular values in descending order
+     * @return Rank singular values
+     */
+    [[nodiscard]] std::vector<Type> const&
+    values() const
+    {
+        return values_;
+    }
+
+    /**
+     * Returns the left singular vectors as columns
+     * @return Rows x Rank orthonormal columns
+     */
+    [[nodiscard]] u_type const&
+    u() const
+    {
+        return *u_;
+    }
+
+    /**
+     * Returns the right singular vectors as columns
+     * @return Columns x Rank orthonormal columns
+     */
+    [[nodiscard]] v_type const&
+    v() const
+    {
+        return *v_;
+    }
+
+private:
+    std::vector<Type>       values_;
+    std::unique_ptr<u_type> u_;
+    std::unique_ptr<v_type> v_;
+
+    /**
+     * One-sided Jacobi (Hestenes) on the sketch x sketch matrix stored by columns in x: rotates column pairs until
+     * all of them are orthogonal, so x ends as X * S with orthogonal X and y, also stored by columns, holds the
+     * accumulated rotations Y. Column norms come out with high relative accuracy.
+     */
+    static void
+    jacobi(Type* x, Type* y)
+    {
+        constexpr auto eps = std::numeric_limits<Type>::epsilon();
+
+        std::fill(y, y + sketch * sketch, Type{});
+        for (std::size_t i{}; i < sketch; i++) {
+            y[i * sketch + i] = Type{1};
+        }
+        for (std::size_t sweep{}; sweep < 64; sweep++) {
+            bool rotated{};
+            for (std::size_t p{}; p + 1 < sketch; p++) {
+                for (std::size_t q{p + 1}; q < sketch; q++) {
+                    Type* xp = &x[p * sketch];
+                    Type* xq = &x[q * sketch];
+                    Type  alpha{};
+                    Type  beta{};
+                    Type  gamma{};
+                    for (std::size_t i{}; i < sketch; i++) {
+                        alpha += xp[i] * xp[i];
+                        beta += xq[i] * xq[i];
+                        gamma += xp[i] * xq[i];
+                    }
+                    if (std::abs(gamma) <= eps * std::sqrt(alpha * beta)) {
+                        continue;
+                    }
+                    rotated         = true;
+                    Type const zeta = (beta - alpha) / (Type{2} * gamma);
+                    Type const t    = std::copysign(Type{1}, zeta) / (std::abs(zeta) + std::hypot(Type{1}, zeta));
+                    Type const c    = Type{1} / std::hypot(Type{1}, t);
+                    Type const s    = c * t;
+                    Type*      yp   = &y[p * sketch];
+                    Type*      yq   = &y[q * sketch];
+                    for (std::size_t i{}; i < sketch; i++) {
+                        Type const xpi = xp[i];
+                        xp[i]          = c * xpi - s * xq[i];
+                        xq[i]          = s * xpi + c * xq[i];
+                        Type const ypi = yp[i];
+                        yp[i]          = c * ypi - s * yq[i];
+                        yq[i]          = s * ypi + c * yq[i];
+                    }
+                }
+            }
+            if (!rotated) {
+                break;
+            }
+        }
+    }
+
+    // Replaces the columns by an orthonormal basis of their span
+    template <std::size_t Size>
+    static void
+    orthonormalize(matrix<Type, Size, sketch, Batch>& columns)
+    {
+        qr<Type, Size, sketch, Batch> const factor{columns};
+        factor.q(columns);
+    }
+};
+
+}    // namespace xitren::math
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <xitren/math/tuning.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace xitren::math {
+
+/**
+ * Returns the number of worker threads used by the parallel kernels
+ * @return the tuned number of threads, at least one
+ */
+inline std::size_t
+parallel_threads()
+{
+    return std::max<std::size_t>(1, tuning::current().threads);
+}
+
+/**
+ * Splits [0, count) into contiguous ranges and runs them on worker threads
+ * @param count the number of items
+ * @param grain the minimal number of items worth a thread
+ * @param func callable taking (begin, end) of its range
+ */
+template <class Func>
+void
+parallel_for(std::size_t count, std::size_t grain, Func func)
+{
+    auto const workers = std::min(parallel_threads(), count / std::max<std::size_t>(grain, 1));
+    if (workers <= 1) {
+        func(std::size_t{}, count);
+        return;
+    }
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    auto const step = (count + workers - 1) / workers;
+    for (std::size_t begin{step}; begin < count; begin += step) {
+        threads.emplace_back([&func, begin, end = std::min(begin + step, count)] { func(begin, end); });
+    }
+    func(std::size_t{}, std::min(step, count));
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+}    // namespace xitren::math
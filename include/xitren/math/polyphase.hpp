@@ -0,0 +1,312 @@
+#pragma once
+
+#include <xitren/math/fir.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace xitren::math {
+
+namespace detail {
+
+/**
+ * Polyphase split of a table filtering a signal zero-stuffed by L: output phase p only meets the taps
+ * h[first_p], h[first_p + L], ... that fall on input samples, scaled by L to keep the passband gain.
+ */
+template <std::size_t Taps, std::size_t L>
+class polyphase_branches {
+public:
+    /// Input samples before the current one that a branch can reach
+    static constexpr std::size_t history = (Taps - 1 + L - 1) / L;
+
+    explicit polyphase_branches(std::array<double, Taps> const& table)
+    {
+        for (std::size_t p{}; p < L; p++) {
+            // Tap i meets input n + (i + p + 1 - Taps) / L when that difference is a multiple of L
+            auto const first = (Taps - 1 + L * Taps - p) % L;
+            if (first >= Taps) {
+                continue;
+            }
+            for (auto i = first; i < Taps; i += L) {
+                branches_[p].push_back(static_cast<double>(L) * table[i]);
+            }
+            offsets_[p] = history - (Taps - 1 - p - first) / L;
+        }
+    }
+
+    /**
+     * Output phase p of an input
+     * @param p the phase
+     * @param line the line of inputs, the current input is at line[history]
+     * @return the output
+     */
+    double
+    value(std::size_t p, double const* line) const
+    {
+        auto const&   branch = branches_[p];
+        double const* window = line + offsets_[p];
+        double        sum{};
+        for (std::size_t j{}; j < branch.size(); j++) {
+            sum += branch[j] * window[j];
+        }
+        return sum;
+    }
+
+private:
+    std::array<std::vector<double>, L> branches_;
+    std::array<std::size_t, L>         offsets_{};
+};
+
+}    // namespace detail
+
+/**
+ * Decimation by M behind a lowpass<Order, 1, 2 * M> anti-aliasing filter.
+ * Only the kept outputs are computed: every M-th input produces one output, the dot product of the Order + 1
+ * coefficients with the contiguous window ending at that input. The M polyphase branches h[p], h[p + M], ...
+ * are interleaved in that window, so one output costs Order + 1 multiplies instead of M * (Order + 1).
+ * Output m equals what the lowpass filter's value() returns for input m * M + M - 1.
+ */
+template <std::size_t Order, std::size_t M>
+class decimator {
+    static_assert(M >= 1, "Decimation factor should be positive!");
+
+public:
+    static constexpr std::size_t taps = Order + 1;
+
+    decimator() : table_{lowpass<Order, 1, 2 * M>::prepare_table()}, line_(taps - 1 + chunk) {}
+
+    /**
+     * Returns the number of outputs the next process() call produces
+     * @param inputs the number of inputs of the call
+     * @return the number of outputs
+     */
+    [[nodiscard]] std::size_t
+    capacity(std::size_t inputs) const
+    {
+        return static_cast<std::size_t>((seen_ + inputs) / M - seen_ / M);
+    }
+
+    /**
+     * Decimates a block, the position inside the current group of M inputs is kept across calls
+     * @param in the input samples, all of them are consumed
+     * @param out the output samples, at least capacity(in.size())
+     * @return the number of outputs written
+     */
+    std::size_t
+    process(std::span<double const> in, std::span<double> out)
+    {
+        if (out.size() < capacity(in.size())) {
+            throw std::length_error{"decimator: output block is too short"};
+        }
+        std::size_t written{};
+        for (std::size_t done{}; done < in.size();) {
+            auto const count = std::min(chunk, in.size() - done);
+            std::copy_n(in.begin() + done, count, line_.begin() + (taps - 1));
+            // The first kept input of the chunk completes the current group
+            for (auto t = (M - 1 - (seen_ + done) % M) % M; t < count; t += M) {
+                out[written++] = (seen_ + done + t + 1 < taps) ? 0. : dot(&line_[t]);
+            }
+            std::copy_n(line_.begin() + count, taps - 1, line_.begin());
+            done += count;
+        }
+        seen_ += in.size();
+        return written;
+    }
+
+    /**
+     * Resets the filter state
+     */
+    void
+    reset()
+    {
+        std::fill(line_.begin(), line_.end(), 0.);
+        seen_ = 0;
+    }
+
+    /**
+     * Returns the filter table data
+     * @return the filter table data
+     */
+    std::array<double, taps>
+    table() const
+    {
+        return table_;
+    }
+
+private:
+    static constexpr std::size_t chunk = 256 * M;
+
+    std::array<double, taps> table_;
+    std::vector<double>      line_;    // taps - 1 samples of history followed by the current chunk
+    std::uint64_t            seen_{};
+
+    double
+    dot(double const* window) const
+    {
+        double sum{};
+        for (std::size_t i{}; i < taps; i++) {
+            sum += table_[i] * window[i];
+        }
+        return sum;
+    }
+};
+
+/**
+ * Interpolation by L through a lowpass<Order, 1, 2 * L> image rejection filter.
+ * The coefficients are split into L polyphase branches, output phase p of every input uses only the taps that
+ * meet non-zero samples of the zero-stuffed signal, so no multiply touches an inserted zero.
+ * Output n * L + p equals L times what the lowpass filter's value() returns after input n followed by p zeros.
+ */
+template <std::size_t Order, std::size_t L>
+class interpolator {
+    static_assert(L >= 1, "Interpolation factor should be positive!");
+
+public:
+    static constexpr std::size_t taps = Order + 1;
+
+    interpolator() : branches_{lowpass<Order, 1, 2 * L>::prepare_table()}, line_(history + chunk) {}
+
+    /**
+     * Returns the number of outputs the next process() call produces
+     * @param inputs the number of inputs of the call
+     * @return the number of outputs
+     */
+    [[nodiscard]] static constexpr std::size_t
+    capacity(std::size_t inputs)
+    {
+        return inputs * L;
+    }
+
+    /**
+     * Interpolates a block
+     * @param in the input samples, all of them are consumed
+     * @param out the output samples, at least capacity(in.size())
+     * @return the number of outputs written
+     */
+    std::size_t
+    process(std::span<double const> in, std::span<double> out)
+    {
+        if (out.size() < capacity(in.size())) {
+            throw std::length_error{"interpolator: output block is too short"};
+        }
+        auto const  size = in.size();
+        std::size_t written{};
+        for (std::size_t done{}; done < size;) {
+            auto const count = std::min(chunk, size - done);
+            std::copy_n(in.begin() + done, count, line_.begin() + history);
+            for (std::size_t n{}; n < count; n++) {
+                for (std::size_t p{}; p < L; p++) {
+                    auto const index = (seen_ + done + n) * L + p;
+                    out[written++]   = (index + 1 < taps) ? 0. : branches_.value(p, &line_[n]);
+                }
+            }
+            std::copy_n(line_.begin() + count, history, line_.begin());
+            done += count;
+        }
+        seen_ += size;
+        return written;
+    }
+
+    /**
+     * Resets the filter state
+     */
+    void
+    reset()
+    {
+        std::fill(line_.begin(), line_.end(), 0.);
+        seen_ = 0;
+    }
+
+private:
+    static constexpr std::size_t chunk   = 256;
+    static constexpr std::size_t history = detail::polyphase_branches<taps, L>::history;
+
+    detail::polyphase_branches<taps, L> branches_;
+    std::vector<double>                 line_;    // history inputs followed by the current chunk
+    std::uint64_t                       seen_{};
+};
+
+/**
+ * Streaming rational sample rate converter: L / M times the input rate.
+ * Conceptually the input is zero-stuffed by L, filtered by lowpass<Order, 1, 2 * max(L, M)> and every M-th
+ * sample is kept. Only the kept samples are computed, each from the single polyphase branch of its phase, so the
+ * cost is about (Order + 1) / L multiplies per output whatever the intermediate rate.
+ * Output m equals L times what the lowpass filter's value() returns for zero-stuffed sample m * M.
+ */
+template <std::size_t L, std::size_t M, std::size_t Order = 16 * std::max(L, M)>
+class resampler {
+    static_assert(L >= 1 && M >= 1, "Rate factors should be positive!");
+
+public:
+    static constexpr std::size_t taps = Order + 1;
+
+    resampler() : branches_{lowpass<Order, 1, 2 * std::max(L, M)>::prepare_table()}, line_(history + chunk) {}
+
+    /**
+     * Returns the number of outputs the next process() call produces
+     * @param inputs the number of inputs of the call
+     * @return the number of outputs
+     */
+    [[nodiscard]] std::size_t
+    capacity(std::size_t inputs) const
+    {
+        auto const end = (seen_ + inputs) * L;
+        return (end > next_) ? static_cast<std::size_t>((end - next_ + M - 1) / M) : 0;
+    }
+
+    /**
+     * Converts a block, the filter state and the output phase are kept across calls
+     * @param in the input samples
+     * @param out the output samples, at least capacity(in.size())
+     * @return the number of outputs written
+     */
+    std::size_t
+    process(std::span<double const> in, std::span<double> out)
+    {
+        if (out.size() < capacity(in.size())) {
+            throw std::length_error{"resampler: output block is too short"};
+        }
+        std::size_t written{};
+        for (std::size_t done{}; done < in.size();) {
+            auto const count = std::min(chunk, in.size() - done);
+            auto const first = seen_ + done;
+            std::copy_n(in.begin() + done, count, line_.begin() + history);
+            for (; next_ / L < first + count; next_ += M) {
+                auto const n     = static_cast<std::size_t>(next_ / L - first);
+                auto const phase = static_cast<std::size_t>(next_ % L);
+                out[written++]   = (next_ + 1 < taps) ? 0. : branches_.value(phase, &line_[n]);
+            }
+            std::copy_n(line_.begin() + count, history, line_.begin());
+            done += count;
+        }
+        seen_ += in.size();
+        return written;
+    }
+
+    /**
+     * Resets the filter state and the output phase
+     */
+    void
+    reset()
+    {
+        std::fill(line_.begin(), line_.end(), 0.);
+        seen_ = 0;
+        next_ = 0;
+    }
+
+private:
+    static constexpr std::size_t chunk   = 256;
+    static constexpr std::size_t history = detail::polyphase_branches<taps, L>::history;
+
+    detail::polyphase_branches<taps, L> branches_;
+    std::vector<double>                 line_;    // history inputs followed by the current chunk
+    std::uint64_t                       seen_{};
+    std::uint64_t                       next_{};    // zero-stuffed index of the next output
+};
+
+}    // namespace xitren::math
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <xitren/math/parallel.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <type_traits>
+
+namespace xitren::math {
+
+/**
+ * Counter-based generator (SplitMix64 finalizer over seed and counter).
+ * Every value is a pure function of (seed, counter), so any element can be generated independently:
+ * fills run in parallel, vectorize, and give the same result regardless of the thread split.
+ */
+class counter_random {
+    static constexpr std::uint64_t golden_ = 0x9e3779b97f4a7c15ULL;
+
+public:
+    /**
+     * Mixes the value with the SplitMix64 finalizer
+     * @param value the value to mix
+     * @return the mixed value
+     */
+    static constexpr std::uint64_t
+    mix(std::uint64_t value)
+    {
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+        return value ^ (value >> 31);
+    }
+
+    /**
+     * Returns 64 random bits of the stream
+     * @param seed the stream seed
+     * @param counter the position in the stream
+     * @return the random bits
+     */
+    static constexpr std::uint64_t
+    bits(std::uint64_t seed, std::uint64_t counter)
+    {
+        return mix(mix(seed) + (counter + 1) * golden_);
+    }
+
+    /**
+     * Returns a random value of the stream: uniform in [0, 1) for floating point types,
+     * uniform in [0, RAND_MAX] cast to the type for integral types (the range std::rand() gave)
+     * @param seed the stream seed
+     * @param counter the position in the stream
+     * @return the random value
+     */
+    template <class Type>
+    static constexpr Type
+    value(std::uint64_t seed, std::uint64_t counter)
+    {
+        auto const random = bits(seed, counter);
+        if constexpr (std::is_floating_point_v<Type>) {
+            return static_cast<Type>(static_cast<double>(random >> 11) * 0x1.0p-53);
+        } else {
+            return static_cast<Type>(random % (static_cast<std::uint64_t>(RAND_MAX) + 1));
+        }
+    }
+
+    /**
+     * Returns a fresh seed, different on every call, safe to call from several threads
+     * @return the seed
+     */
+    static std::uint64_t
+    seed()
+    {
+        static std::atomic<std::uint64_t> state{(static_cast<std::uint64_t>(std::random_device{}()) << 32)
+                                                ^ std::random_device{}()};
+        return mix(state.fetch_add(golden_, std::memory_order_relaxed));
+    }
+
+    /**
+     * Fills the range with the stream values [offset, offset + count) in parallel
+     * @param data the destination
+     * @param count the number of values
+     * @param seed the stream seed
+     * @param offset the stream position of the first value
+     */
+    template <class Type>
+    static void
+    fill(Type* data, std::size_t count, std::uint64_t seed, std::uint64_t offset = 0)
+    {
+        parallel_for(count, grain, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i{begin}; i < end; i++) {
+                data[i] = value<Type>(seed, offset + i);
+            }
+        });
+    }
+
+    /// Minimal number of values worth a thread
+    static constexpr std::size_t grain = 1 << 16;
+};
+
+}    // namespace xitren::math
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+
+namespace xitren::math {
+
+/**
+ * Semirings for the matrix products. Each one provides the additive identity zero(), the multiplicative identity
+ * one(), add() and mul(). has_subtraction tells whether additive inverses exist, only then Strassen's
+ * recombination of the partial products is valid.
+ */
+
+namespace detail {
+
+/**
+ * a + b clamped to [lowest(), max()] for integral types, plain a + b for floating ones
+ */
+template <class Type>
+constexpr Type
+saturating_add(Type a, Type b)
+{
+    if constexpr (std::numeric_limits<Type>::is_integer) {
+        if ((b > Type{0}) && (a > std::numeric_limits<Type>::max() - b)) {
+            return std::numeric_limits<Type>::max();
+        }
+        if constexpr (std::numeric_limits<Type>::is_signed) {
+            if ((b < Type{0}) && (a < std::numeric_limits<Type>::lowest() - b)) {
+                return std::numeric_limits<Type>::lowest();
+            }
+        }
+    }
+    return static_cast<Type>(a + b);
+}
+
+}    // namespace detail
+
+/**
+ * Ordinary arithmetic (+, *)
+ */
+template <class Type>
+struct plus_times {
+    static constexpr bool has_subtraction = true;
+
+    static constexpr Type
+    zero()
+    {
+        return Type{0};
+    }
+
+    static constexpr Type
+    one()
+    {
+        return Type{1};
+    }
+
+    static constexpr Type
+    add(Type a, Type b)
+    {
+        return a + b;
+    }
+
+    static constexpr Type
+    mul(Type a, Type b)
+    {
+        return a * b;
+    }
+};
+
+/**
+ * Tropical semiring (min, +), the product of two distance matrices gives the shortest two step paths.
+ * zero() is infinity for floating types and max() for integral ones. For integral types mul() saturates:
+ * a sum above max() becomes zero(), one below lowest() becomes lowest().
+ */
+template <class Type>
+struct min_plus {
+    static constexpr bool has_subtraction = false;
+
+    static constexpr Type
+    zero()
+    {
+        if constexpr (std::numeric_limits<Type>::has_infinity) {
+            return std::numeric_limits<Type>::infinity();
+        } else {
+            return std::numeric_limits<Type>::max();
+        }
+    }
+
+    static constexpr Type
+    one()
+    {
+        return Type{0};
+    }
+
+    static constexpr Type
+    add(Type a, Type b)
+    {
+        return b < a ? b : a;
+    }
+
+    static constexpr Type
+    mul(Type a, Type b)
+    {
+        if constexpr (!std::numeric_limits<Type>::has_infinity) {
+            if ((a == zero()) || (b == zero())) {
+                return zero();
+            }
+        }
+        return detail::saturating_add(a, b);
+    }
+};
+
+/**
+ * Max-plus semiring (max, +), the product gives the longest two step paths, e.g. for scheduling.
+ * zero() is minus infinity for floating types and lowest() for integral ones. For integral types mul() saturates:
+ * a sum below lowest() becomes zero(), one above max() becomes max().
+ */
+template <class Type>
+struct max_plus {
+    static constexpr bool has_subtraction = false;
+
+    static constexpr Type
+    zero()
+    {
+        if constexpr (std::numeric_limits<Type>::has_infinity) {
+            return -std::numeric_limits<Type>::infinity();
+        } else {
+            return std::numeric_limits<Type>::lowest();
+        }
+    }
+
+    static constexpr Type
+    one()
+    {
+        return Type{0};
+    }
+
+    static constexpr Type
+    add(Type a, Type b)
+    {
+        return a < b ? b : a;
+    }
+
+    static constexpr Type
+    mul(Type a, Type b)
+    {
+        if constexpr (!std::numeric_limits<Type>::has_infinity) {
+            if ((a == zero()) || (b == zero())) {
+                return zero();
+            }
+        }
+        return detail::saturating_add(a, b);
+    }
+};
+
+/**
+ * Max-times semiring (max, *) over non-negative values, e.g. the most reliable two step paths
+ */
+template <class Type>
+struct max_times {
+    static constexpr bool has_subtraction = false;
+
+    static constexpr Type
+    zero()
+    {
+        return Type{0};
+    }
+
+    static constexpr Type
+    one()
+    {
+        return Type{1};
+    }
+
+    static constexpr Type
+    add(Type a, Type b)
+    {
+        return a < b ? b : a;
+    }
+
+    static constexpr Type
+    mul(Type a, Type b)
+    {
+        return a * b;
+    }
+};
+
+}    // namespace xitren::math
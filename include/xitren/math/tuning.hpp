@@ -0,0 +1,186 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#ifndef XITREN_MATH_BATCH
+// Upper bound of the batch value matrix picks by default, set it to the batch measured by autotune
+#    define XITREN_MATH_BATCH 128
+#endif
+
+#ifndef XITREN_MATH_CACHE_SIZE
+// Per-core cache, in bytes, that should hold the operand and result tiles of the default batch value
+#    define XITREN_MATH_CACHE_SIZE (1024 * 1024)
+#endif
+
+#ifndef XITREN_MATH_STREAM_SIZE
+// Output size, in bytes, above which write-only kernels bypass the caches with streaming stores
+#    define XITREN_MATH_STREAM_SIZE (16 * 1024 * 1024)
+#endif
+
+namespace xitren::math {
+
+/**
+ * Run-time parameters of the dynamic kernels.
+ * Defaults are used until the caller installs others, see tuning::set() and tuning::load().
+ */
+struct tuning_parameters {
+    /// Batch value measured best for matrix. Advisory only: no kernel reads it at run time, loading or setting
+    /// it changes nothing until the code is rebuilt with XITREN_MATH_BATCH set to this value
+    std::size_t batch{128};
+    /// matrix_strassen products at or below this size use the classical kernel instead of recursing further,
+    /// the default recurses down to the 2 x 2 products
+    std::size_t strassen_cutoff{2};
+    /// Rows of the classical micro-kernel sharing every loaded row of the right operand: 1, 2, 4 or 8
+    std::size_t kernel_rows{2};
+    /// Worker threads of the parallel kernels
+    std::size_t threads{std::max(1U, std::thread::hardware_concurrency())};
+};
+
+class tuning {
+public:
+    tuning() = delete;
+
+    /**
+     * Returns the parameters in use. Every field is stored atomically, so set() may run concurrently with
+     * products: a reader sees each field either old or new, and any such mix is a valid parameter set.
+     * @return the parameters
+     */
+    static tuning_parameters
+    current()
+    {
+        auto const& fields = storage();
+        return tuning_parameters{fields.batch.load(std::memory_order_relaxed),
+                                 fields.strassen_cutoff.load(std::memory_order_relaxed),
+                                 fields.kernel_rows.load(std::memory_order_relaxed),
+                                 fields.threads.load(std::memory_order_relaxed)};
+    }
+
+    /**
+     * Replaces the parameters in use
+     * @param params the new parameters
+     */
+    static void
+    set(tuning_parameters const& params)
+    {
+        auto& fields = storage();
+        fields.batch.store(params.batch, std::memory_order_relaxed);
+        fields.strassen_cutoff.store(params.strassen_cutoff, std::memory_order_relaxed);
+        fields.kernel_rows.store(params.kernel_rows, std::memory_order_relaxed);
+        fields.threads.store(params.threads, std::memory_order_relaxed);
+    }
+
+    /**
+     * Reads a tuning file over the parameters in use. Nothing is read implicitly: call this once at start-up,
+     * for example with default_path(), to apply the autotune results. The batch entry is only recorded, see
+     * tuning_parameters::batch
+     * @param path the tuning file
+     * @return true if the file was read
+     */
+    static bool
+    load(std::filesystem::path const& path)
+    {
+        auto params = current();
+        if (!load(path, params)) {
+            return false;
+        }
+        set(params);
+        return true;
+    }
+
+    /**
+     * Returns the tuning file location: the XITREN_MATH_TUNING environment variable or
+     * xitren_math_tuning.cfg in the working directory
+     * @return the file path
+     */
+    static std::filesystem::path
+    default_path()
+    {
+        if (auto const* env = std::getenv("XITREN_MATH_TUNING")) {
+            return env;
+        }
+        return "xitren_math_tuning.cfg";
+    }
+
+    /**
+     * Reads "key = value" lines, unknown keys and malformed lines are skipped
+     * @param path the tuning file
+     * @param params the parameters to update
+     * @return true if the file was read
+     */
+    static bool
+    load(std::filesystem::path const& path, tuning_parameters& params)
+    {
+        std::ifstream file{path};
+        if (!file) {
+            return false;
+        }
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream stream{line};
+            std::string        key;
+            char               equal{};
+            std::size_t        value{};
+            if (!(stream >> key >> equal >> value) || (equal != '=') || (value == 0)) {
+                continue;
+            }
+            if (key == "batch") {
+                params.batch = value;
+            } else if (key == "strassen_cutoff") {
+                params.strassen_cutoff = value;
+            } else if (key == "kernel_rows") {
+                params.kernel_rows = value;
+            } else if (key == "threads") {
+                params.threads = value;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Writes the parameters as "key = value" lines
+     * @param path the tuning file
+     * @param params the parameters
+     * @return true if the file was written
+     */
+    static bool
+    save(std::filesystem::path const& path, tuning_parameters const& params)
+    {
+        std::ofstream file{path};
+        file << "batch = " << params.batch << "\n"
+             << "strassen_cutoff = " << params.strassen_cutoff << "\n"
+             << "kernel_rows = " << params.kernel_rows << "\n"
+             << "threads = " << params.threads << "\n";
+        return static_cast<bool>(file);
+    }
+
+private:
+    struct atomic_parameters {
+        std::atomic<std::size_t> batch;
+        std::atomic<std::size_t> strassen_cutoff;
+        std::atomic<std::size_t> kernel_rows;
+        std::atomic<std::size_t> threads;
+    };
+
+    static atomic_parameters&
+    storage()
+    {
+        static atomic_parameters fields = [] {
+            tuning_parameters const defaults{};
+            return atomic_parameters{{defaults.batch},
+                                     {defaults.strassen_cutoff},
+                                     {defaults.kernel_rows},
+                                     {defaults.threads}};
+        }();
+        return fields;
+    }
+};
+
+}    // namespace xitren::math
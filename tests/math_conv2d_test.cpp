@@ -0,0 +1,145 @@
+#include <xitren/math/conv2d.hpp>
+#include <xitren/math/random.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+using namespace xitren::math;
+
+template <class Type, std::size_t Height, std::size_t Width, std::size_t Channels, std::size_t Filters,
+          std::size_t Kernel, class Input>
+static std::vector<Type>
+direct(std::array<Input, Channels * Height * Width> const&           in,
+       std::array<Type, Filters * Channels * Kernel * Kernel> const& w)
+{
+    constexpr auto    oh = Height - Kernel + 1;
+    constexpr auto    ow = Width - Kernel + 1;
+    std::vector<Type> out(Filters * oh * ow);
+    for (std::size_t f{}; f < Filters; f++) {
+        for (std::size_t y{}; y < oh; y++) {
+            for (std::size_t x{}; x < ow; x++) {
+                Type sum{};
+                for (std::size_t c{}; c < Channels; c++) {
+                    for (std::size_t ky{}; ky < Kernel; ky++) {
+                        for (std::size_t kx{}; kx < Kernel; kx++) {
+                            sum += static_cast<Type>(in[(c * Height + y + ky) * Width + x + kx])
+                                   * w[((f * Channels + c) * Kernel + ky) * Kernel + kx];
+                        }
+                    }
+                }
+                out[(f * oh + y) * ow + x] = sum;
+            }
+        }
+    }
+    return out;
+}
+
+template <class Array>
+static void
+fill_image(Array& image, std::uint64_t seed)
+{
+    for (std::size_t i{}; i < image.size(); i++) {
+        image[i] = static_cast<typename Array::value_type>(counter_random::bits(seed, i));
+    }
+}
+
+TEST(conv2d_test, im2col_and_winograd_int)
+{
+    // Odd output sizes exercise the partial Winograd tiles
+    constexpr std::size_t height = 23;
+    constexpr std::size_t width  = 30;
+    using conv_type              = conv2d<std::int32_t, height, width, 3, 4, 3, 8>;
+
+    static std::array<std::uint8_t, 3 * height * width> image;
+    fill_image(image, 1);
+    conv_type::weights_type weights;
+    for (std::size_t i{}; i < weights.size(); i++) {
+        weights[i] = static_cast<std::int32_t>(counter_random::bits(2, i) % 11) - 5;
+    }
+    auto const expected = direct<std::int32_t, height, width, 3, 4, 3>(image, weights);
+
+    conv_type const conv{weights};
+    static conv_type::output_type out;
+    conv.im2col(image, out);
+    EXPECT_TRUE(std::equal(out.begin(), out.end(), expected.begin()));
+    conv.im2col<4>(image, out);
+    EXPECT_TRUE(std::equal(out.begin(), out.end(), expected.begin()));
+    conv.winograd(image, out);
+    EXPECT_TRUE(std::equal(out.begin(), out.end(), expected.begin()));
+    conv.winograd<6>(image, out);
+    EXPECT_TRUE(std::equal(out.begin(), out.end(), expected.begin()));
+}
+
+TEST(conv2d_test, single_channel_float)
+{
+    constexpr std::size_t height = 16;
+    constexpr std::size_t width  = 17;
+    using conv_type              = conv2d<float, height, width, 1, 1, 3, 4>;
+
+    static std::array<std::uint8_t, height * width> image;
+    fill_image(image, 3);
+    conv_type::weights_type const weights{{0.f, -1.f, 0.f, -1.f, 4.f, -1.f, 0.f, -1.f, 0.f}};
+    auto const                    expected = direct<float, height, width, 1, 1, 3>(image, weights);
+
+    conv_type const conv{weights};
+    static conv_type::output_type out;
+    conv.winograd<2>(image, out);
+    for (std::size_t i{}; i < out.size(); i++) {
+        EXPECT_FLOAT_EQ(out[i], expected[i]);
+    }
+    conv.im2col<1>(image, out);
+    for (std::size_t i{}; i < out.size(); i++) {
+        EXPECT_FLOAT_EQ(out[i], expected[i]);
+    }
+}
+
+TEST(conv2d_test, kernel_5)
+{
+    constexpr std::size_t height = 20;
+    constexpr std::size_t width  = 20;
+    using conv_type              = conv2d<std::int32_t, height, width, 2, 3, 5, 8>;
+
+    static std::array<std::uint8_t, 2 * height * width> image;
+    fill_image(image, 4);
+    conv_type::weights_type weights;
+    for (std::size_t i{}; i < weights.size(); i++) {
+        weights[i] = static_cast<std::int32_t>(counter_random::bits(5, i) % 7) - 3;
+    }
+    auto const expected = direct<std::int32_t, height, width, 2, 3, 5>(image, weights);
+
+    conv_type const conv{weights};
+    static conv_type::output_type out;
+    conv.im2col<5>(image, out);
+    EXPECT_TRUE(std::equal(out.begin(), out.end(), expected.begin()));
+}
+
+TEST(conv2d_test, conv2d_256_time)
+{
+    constexpr std::size_t height = 256;
+    constexpr std::size_t width  = 256;
+    using conv_type              = conv2d<float, height, width, 8, 16, 3, 32>;
+
+    auto image = std::make_unique<std::array<std::uint8_t, 8 * height * width>>();
+    fill_image(*image, 6);
+    auto weights = std::make_unique<conv_type::weights_type>();
+    for (std::size_t i{}; i < weights->size(); i++) {
+        (*weights)[i] = static_cast<float>(counter_random::bits(7, i) % 5) - 2.f;
+    }
+    auto const conv = std::make_unique<conv_type>(*weights);
+    auto       out  = std::make_unique<conv_type::output_type>();
+    auto       time = [](auto callback) {
+        auto start = std::chrono::high_resolution_clock::now();
+        callback();
+        auto stop = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count();
+    };
+    std::cout << "im2col 8x256x256 -> 16: " << time([&] { conv->im2col<32>(*image, *out); }) << " us" << std::endl;
+    auto const first = (*out)[1000];
+    std::cout << "Winograd 8x256x256 -> 16: " << time([&] { conv->winograd<32>(*image, *out); }) << " us"
+              << std::endl;
+    EXPECT_FLOAT_EQ(first, (*out)[1000]);
+}
@@ -0,0 +1,62 @@
+#include <xitren/math/delay_line.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+using namespace xitren::math;
+
+template <class Line>
+static std::vector<typename Line::value_type>
+contents(Line const& line)
+{
+    return {line.begin(), line.end()};
+}
+
+TEST(delay_line_test, fills_up)
+{
+    delay_line<double, 4> line;
+    EXPECT_TRUE(line.empty());
+    EXPECT_FALSE(line.full());
+    EXPECT_EQ(line.begin(), line.end());
+    line.push(1.);
+    line.push(2.);
+    EXPECT_EQ(line.size(), 2U);
+    EXPECT_EQ(contents(line), (std::vector<double>{1., 2.}));
+    line << 3. << 4.;
+    EXPECT_TRUE(line.full());
+    EXPECT_EQ(contents(line), (std::vector<double>{1., 2., 3., 4.}));
+}
+
+TEST(delay_line_test, window_is_contiguous)
+{
+    delay_line<std::uint32_t, 5> line;
+    std::vector<std::uint32_t>   pushed;
+    for (std::uint32_t i{}; i < 23; i++) {
+        line.push(i);
+        pushed.push_back(i);
+        auto const window = line.window();
+        ASSERT_EQ(window.size(), std::min<std::size_t>(pushed.size(), 5));
+        EXPECT_EQ(window.data(), line.begin());
+        for (std::size_t k{}; k < window.size(); k++) {
+            EXPECT_EQ(window[k], pushed[pushed.size() - window.size() + k]);
+        }
+    }
+}
+
+TEST(delay_line_test, clear_and_stream)
+{
+    delay_line<int, 3> line;
+    line << std::array<int, 5>{1, 2, 3, 4, 5};
+    EXPECT_TRUE(line.full());
+    EXPECT_EQ(contents(line), (std::vector<int>{3, 4, 5}));
+    line.clear();
+    EXPECT_TRUE(line.empty());
+    line << 7;
+    EXPECT_EQ(contents(line), (std::vector<int>{7}));
+    delay_line<int, 1> single;
+    single << 1 << 2;
+    EXPECT_EQ(contents(single), (std::vector<int>{2}));
+}
@@ -0,0 +1,159 @@
+#include <xitren/math/fft.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace xitren::math;
+
+static std::vector<std::complex<double>>
+naive_dft(std::vector<std::complex<double>> const& in)
+{
+    auto const                             size = in.size();
+    std::vector<std::complex<double>>      out(size);
+    std::vector<std::complex<long double>> roots(size);
+    for (std::size_t i{}; i < size; i++) {
+        auto const angle = -2.0L * M_PI * static_cast<long double>(i) / static_cast<long double>(size);
+        roots[i]         = {std::cos(angle), std::sin(angle)};
+    }
+    for (std::size_t k{}; k < size; k++) {
+        std::complex<long double> sum{};
+        for (std::size_t n{}; n < size; n++) {
+            sum += std::complex<long double>{in[n].real(), in[n].imag()} * roots[(k * n) % size];
+        }
+        out[k] = {static_cast<double>(sum.real()), static_cast<double>(sum.imag())};
+    }
+    return out;
+}
+
+static std::vector<std::complex<double>>
+signal(std::size_t size)
+{
+    std::vector<std::complex<double>> ret(size);
+    for (std::size_t i{}; i < size; i++) {
+        ret[i] = {std::sin(0.37 * static_cast<double>(i * i % 101)), std::cos(1.3 * static_cast<double>(i)) - 0.25};
+    }
+    return ret;
+}
+
+static double
+max_error(std::vector<std::complex<double>> const& a, std::vector<std::complex<double>> const& b)
+{
+    double ret{};
+    for (std::size_t i{}; i < a.size(); i++) {
+        ret = std::max(ret, std::abs(a[i] - b[i]));
+    }
+    return ret;
+}
+
+TEST(fft_test, complex_against_dft)
+{
+    std::vector<std::size_t> sizes;
+    for (std::size_t size{1}; size <= 64; size++) {
+        sizes.push_back(size);
+    }
+    for (std::size_t size : {97, 121, 360, 1000, 1024, 2048, 4096}) {
+        sizes.push_back(size);
+    }
+    for (auto size : sizes) {
+        auto const in       = signal(size);
+        auto const expected = naive_dft(in);
+        auto       data     = in;
+        fft_plan<double> plan{size};
+        plan.forward(data.data());
+        EXPECT_LT(max_error(expected, data), 1e-10 * static_cast<double>(size)) << "size " << size;
+        plan.inverse(data.data());
+        EXPECT_LT(max_error(in, data), 1e-12 * static_cast<double>(size)) << "size " << size;
+    }
+}
+
+TEST(fft_test, float_plan)
+{
+    constexpr std::size_t           size = 768;
+    auto const                      in   = signal(size);
+    auto const                      expected = naive_dft(in);
+    std::vector<std::complex<float>> data(size);
+    for (std::size_t i{}; i < size; i++) {
+        data[i] = {static_cast<float>(in[i].real()), static_cast<float>(in[i].imag())};
+    }
+    fft_plan<float>::cached(size)->forward(data.data());
+    for (std::size_t i{}; i < size; i++) {
+        EXPECT_NEAR(expected[i].real(), data[i].real(), 1e-3);
+        EXPECT_NEAR(expected[i].imag(), data[i].imag(), 1e-3);
+    }
+}
+
+TEST(fft_test, real_against_dft)
+{
+    for (std::size_t size : {2, 4, 6, 10, 16, 18, 30, 64, 250, 1024}) {
+        std::vector<double>               in(size);
+        std::vector<std::complex<double>> complex_in(size);
+        for (std::size_t i{}; i < size; i++) {
+            in[i]         = std::sin(0.3 * static_cast<double>(i)) + static_cast<double>(i % 5) * 0.2;
+            complex_in[i] = in[i];
+        }
+        auto const                        expected = naive_dft(complex_in);
+        std::vector<std::complex<double>> bins(size / 2 + 1);
+        auto const                        plan = fft_real_plan<double>::cached(size);
+        plan->forward(in.data(), bins.data());
+        for (std::size_t k{}; k <= size / 2; k++) {
+            EXPECT_NEAR(expected[k].real(), bins[k].real(), 1e-9) << "size " << size << " bin " << k;
+            EXPECT_NEAR(expected[k].imag(), bins[k].imag(), 1e-9) << "size " << size << " bin " << k;
+        }
+        std::vector<double> back(size);
+        plan->inverse(bins.data(), back.data());
+        for (std::size_t i{}; i < size; i++) {
+            EXPECT_NEAR(in[i], back[i], 1e-12) << "size " << size;
+        }
+    }
+}
+
+TEST(fft_test, shared_plan_threads)
+{
+    constexpr std::size_t size = 4096;
+    auto const            plan = fft_plan<double>::cached(size);
+    EXPECT_EQ(plan, fft_plan<double>::cached(size));
+    auto const               in       = signal(size);
+    auto                     expected = in;
+    plan->forward(expected.data());
+    std::vector<std::thread> threads;
+    std::vector<double>      errors(4);
+    for (std::size_t t{}; t < errors.size(); t++) {
+        threads.emplace_back([&, t] {
+            for (int repeat{}; repeat < 20; repeat++) {
+                auto data = in;
+                plan->forward(data.data());
+                errors[t] = std::max(errors[t], max_error(expected, data));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (auto error : errors) {
+        EXPECT_EQ(error, 0.);
+    }
+}
+
+TEST(fft_test, throughput)
+{
+    for (std::size_t size : {1024, 4096, 65536, 1000, 3 * 1024}) {
+        auto const plan    = fft_plan<double>::cached(size);
+        auto       data    = signal(size);
+        int const  repeats = static_cast<int>(std::max<std::size_t>(4, (std::size_t{1} << 22) / size));
+        auto       start   = std::chrono::high_resolution_clock::now();
+        for (int repeat{}; repeat < repeats; repeat++) {
+            plan->forward(data.data());
+        }
+        auto       stop = std::chrono::high_resolution_clock::now();
+        auto const ns   = std::chrono::duration<double, std::nano>(stop - start).count() / repeats;
+        std::cout << "complex fft " << size << ": " << ns / 1000 << " us, "
+                  << 5.0 * static_cast<double>(size) * std::log2(static_cast<double>(size)) / ns << " GFLOPS"
+                  << std::endl;
+    }
+}
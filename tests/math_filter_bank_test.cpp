@@ -0,0 +1,116 @@
+#include <xitren/math/filter_bank.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <span>
+#include <vector>
+
+using namespace xitren::math;
+
+static double
+sample(std::size_t channel, std::size_t frame)
+{
+    return std::sin(0.01 * static_cast<double>(frame * frame) + static_cast<double>(channel))
+           + static_cast<double>((frame + channel) % 7) * 0.1;
+}
+
+template <std::size_t Order, std::size_t Channels>
+static void
+check_bank(std::array<double, Order> const& table, std::size_t frames, std::size_t step, frame_layout layout)
+{
+    filter_bank<Order, Channels> bank{table};
+    std::vector<double>          in(frames * Channels);
+    std::vector<double>          out(frames * Channels);
+    std::vector<double>          block_in(step * Channels);
+    std::vector<double>          block_out(step * Channels);
+    for (std::size_t f{}; f < frames; f++) {
+        for (std::size_t c{}; c < Channels; c++) {
+            in[f * Channels + c] = sample(c, f);
+        }
+    }
+    for (std::size_t done{}; done < frames; done += step) {
+        auto const count = std::min(step, frames - done);
+        for (std::size_t f{}; f < count; f++) {
+            for (std::size_t c{}; c < Channels; c++) {
+                auto const index = (layout == frame_layout::interleaved) ? f * Channels + c : c * count + f;
+                block_in[index]  = in[(done + f) * Channels + c];
+            }
+        }
+        auto const size = count * Channels;
+        ASSERT_EQ(bank.process(std::span{block_in}.first(size), std::span{block_out}.first(size), layout), count);
+        for (std::size_t f{}; f < count; f++) {
+            for (std::size_t c{}; c < Channels; c++) {
+                auto const index                = (layout == frame_layout::interleaved) ? f * Channels + c : c * count + f;
+                out[(done + f) * Channels + c] = block_out[index];
+            }
+        }
+    }
+    for (std::size_t c{}; c < Channels; c++) {
+        filter<Order> reference{table};
+        for (std::size_t f{}; f < frames; f++) {
+            EXPECT_NEAR(reference.value(in[f * Channels + c]), out[f * Channels + c], 1e-12) << c << " " << f;
+        }
+    }
+}
+
+TEST(filter_bank_test, matches_filter)
+{
+    auto const table = bandpass<62, 20, 60, 250>::prepare_table();
+    check_bank<63, 64>(table, 300, 300, frame_layout::interleaved);
+    check_bank<63, 64>(table, 300, 17, frame_layout::interleaved);
+    check_bank<63, 64>(table, 300, 41, frame_layout::planar);
+    check_bank<63, 7>(table, 200, 9, frame_layout::interleaved);
+    check_bank<63, 23>(table, 200, 200, frame_layout::planar);
+    check_bank<1, 5>(std::array<double, 1>{2.}, 20, 3, frame_layout::interleaved);
+}
+
+TEST(filter_bank_test, frame_by_frame)
+{
+    auto const               table = lowpass<20, 20, 250>::prepare_table();
+    filter_bank<21, 4>       bank{table};
+    std::array<filter<21>, 4> reference{filter<21>{table}, filter<21>{table}, filter<21>{table}, filter<21>{table}};
+    for (std::size_t f{}; f < 100; f++) {
+        std::array<double, 4> frame{sample(0, f), sample(1, f), sample(2, f), sample(3, f)};
+        std::array<double, 4> out{};
+        bank.value(frame, out);
+        for (std::size_t c{}; c < 4; c++) {
+            EXPECT_NEAR(reference[c].value(frame[c]), out[c], 1e-12);
+        }
+    }
+    bank.reset();
+    std::array<double, 4> out{1., 1., 1., 1.};
+    bank.value(std::array<double, 4>{1., 1., 1., 1.}, out);
+    EXPECT_EQ(out[0], 0.);
+}
+
+TEST(filter_bank_test, time)
+{
+    constexpr std::size_t channels = 128;
+    constexpr std::size_t frames   = 1024;
+    auto const            table    = bandpass<62, 20, 60, 250>::prepare_table();
+    std::vector<double>   in(frames * channels);
+    std::vector<double>   out(frames * channels);
+    for (std::size_t i{}; i < in.size(); i++) {
+        in[i] = static_cast<double>(i % 17);
+    }
+    auto bank = std::make_unique<filter_bank<63, channels>>(table);
+    std::vector<filter<63>> filters(channels, filter<63>{table});
+
+    auto start = std::chrono::high_resolution_clock::now();
+    bank->process(in, out);
+    auto stop = std::chrono::high_resolution_clock::now();
+    std::cout << "filter bank 128 channels, 1024 frames, 63 taps: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() << " us" << std::endl;
+    start = std::chrono::high_resolution_clock::now();
+    for (std::size_t f{}; f < frames; f++) {
+        for (std::size_t c{}; c < channels; c++) {
+            out[f * channels + c] = filters[c].value(in[f * channels + c]);
+        }
+    }
+    stop = std::chrono::high_resolution_clock::now();
+    std::cout << "one filter per channel: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() << " us" << std::endl;
+}
@@ -0,0 +1,216 @@
+#include <xitren/math/fir_fast.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <vector>
+
+using namespace xitren::math;
+
+// Hamming windowed sinc lowpass scaled by gain
+template <std::size_t Order>
+static std::array<double, Order>
+sinc_table(double cutoff, double gain)
+{
+    std::array<double, Order> table{};
+    double                    sum{};
+    for (std::size_t i{}; i < Order; i++) {
+        auto const t = static_cast<double>(i) - static_cast<double>(Order - 1) / 2;
+        auto const x = 2 * std::numbers::pi * cutoff * t;
+        table[i]     = (t == 0 ? 1. : std::sin(x) / x)
+                   * (0.54 - 0.46 * std::cos(2 * std::numbers::pi * static_cast<double>(i) / (Order - 1)));
+        sum += table[i];
+    }
+    for (auto& item : table) {
+        item *= gain / sum;
+    }
+    return table;
+}
+
+// Full scale pseudo random samples with runs of both extremes
+template <class Sample>
+static std::vector<Sample>
+signal(std::size_t size)
+{
+    std::vector<Sample> data(size);
+    std::uint64_t       state = 12345;
+    for (std::size_t i{}; i < size; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        if (i % 200 < 40) {
+            data[i] = (i % 400 < 200) ? std::numeric_limits<Sample>::max() : std::numeric_limits<Sample>::min();
+        } else {
+            data[i] = static_cast<Sample>(state >> (64 - 8 * sizeof(Sample)));
+        }
+    }
+    return data;
+}
+
+template <class Sample, class Wide, unsigned Shift, std::size_t Order>
+static Sample
+reference(std::array<Sample, Order> const& table, Sample const* window)
+{
+    Wide sum{};
+    for (std::size_t i{}; i < Order; i++) {
+        sum += static_cast<Wide>(table[i]) * window[i];
+    }
+    sum = (sum + (Wide{1} << (Shift - 1))) >> Shift;
+    return static_cast<Sample>(std::clamp<Wide>(sum, std::numeric_limits<Sample>::min(),
+                                                std::numeric_limits<Sample>::max()));
+}
+
+template <class Filter, class Wide, unsigned Shift, std::size_t Order, class Sample>
+static void
+check_filter(std::array<double, Order> const& table, std::vector<Sample> const& in)
+{
+    Filter              fir{table};
+    std::vector<Sample> out(in.size());
+    ASSERT_EQ(fir.process(in, out), in.size());
+    auto const q = fir.table();
+    for (std::size_t i{}; i < in.size(); i++) {
+        auto const expected = (i + 1 < Order) ? Sample{} : reference<Sample, Wide, Shift>(q, &in[i + 1 - Order]);
+        ASSERT_EQ(out[i], expected) << i;
+    }
+}
+
+TEST(fir_fast_test, q_conversion)
+{
+    EXPECT_EQ(detail::to_q15(0.5), 16384);
+    EXPECT_EQ(detail::to_q15(-1.), -32768);
+    EXPECT_EQ(detail::to_q15(1.), 32767);
+    EXPECT_EQ(detail::to_q15(-3.), -32768);
+    EXPECT_EQ(detail::to_q15(-0.25), -8192);
+    EXPECT_EQ(detail::to_q15(1.4 / 32768.), 1);
+    EXPECT_EQ(detail::to_q15(-1.6 / 32768.), -2);
+    EXPECT_EQ(detail::to_q31(0.5), 1 << 30);
+    EXPECT_EQ(detail::to_q31(1.), std::numeric_limits<std::int32_t>::max());
+    EXPECT_EQ(detail::to_q31(-1.), std::numeric_limits<std::int32_t>::min());
+    EXPECT_EQ(detail::to_q31(-0.25), -(1 << 29));
+}
+
+TEST(fir_fast_test, q15_rounding)
+{
+    // 0.5 * x rounds half up: 1 -> 1, -1 -> 0, 3 -> 2, -3 -> -1
+    std::array<double, 1>     half{0.5};
+    filter_q15<1>             fir{half};
+    std::vector<std::int16_t> in{1, -1, 3, -3, 32767, -32768};
+    std::vector<std::int16_t> out(in.size());
+    fir.process(in, out);
+    EXPECT_EQ(out, (std::vector<std::int16_t>{1, 0, 2, -1, 16384, -16384}));
+}
+
+TEST(fir_fast_test, q15_matches_reference)
+{
+    auto const in = signal<std::int16_t>(3000);
+    check_filter<filter_q15<63>, std::int64_t, 15>(sinc_table<63>(0.1, 1.), in);
+    check_filter<filter_q15<7>, std::int64_t, 15>(sinc_table<7>(0.2, 1.), in);
+    check_filter<filter_q15<100>, std::int64_t, 15>(sinc_table<100>(0.05, 0.9), in);
+}
+
+TEST(fir_fast_test, q15_headroom_bound)
+{
+    // An L1 norm just below 2 keeps the int32 kernel, full scale inputs of opposite sign bring the sum
+    // within 2^21 of -2^31
+    std::array<std::int16_t, 37> a{};
+    std::array<std::int16_t, 37> b{};
+    std::int64_t                 norm{};
+    for (std::size_t i{}; i < a.size(); i++) {
+        a[i] = static_cast<std::int16_t>(i % 2 ? 1771 : -1771);
+        b[i] = (a[i] < 0) ? std::numeric_limits<std::int16_t>::max() : std::numeric_limits<std::int16_t>::min();
+        norm += std::abs(a[i]);
+    }
+    ASSERT_LT(norm, 1 << 16);
+    std::int64_t sum{};
+    for (std::size_t i{}; i < a.size(); i++) {
+        sum += static_cast<std::int32_t>(a[i]) * b[i];
+    }
+    EXPECT_EQ(detail::dot_q15(a.data(), b.data(), a.size()), sum);
+
+    // Multi tap gains between 1 and 2 now run through dot_q15 and still match the exact result
+    auto const             in = signal<std::int16_t>(3000);
+    std::array<double, 40> alternating{};
+    for (std::size_t i{}; i < alternating.size(); i++) {
+        alternating[i] = (i % 2 ? 1.99 : -1.99) / 40;
+    }
+    check_filter<filter_q15<40>, std::int64_t, 15>(alternating, in);
+    check_filter<filter_q15<63>, std::int64_t, 15>(sinc_table<63>(0.1, 1.5), in);
+}
+
+TEST(fir_fast_test, q15_saturates)
+{
+    // Negative lobes and a gain above one leave the int32 headroom
+    auto const in = signal<std::int16_t>(3000);
+    check_filter<filter_q15<63>, std::int64_t, 15>(sinc_table<63>(0.1, 3.), in);
+    std::array<double, 40> flat{};
+    std::fill(flat.begin(), flat.end(), 0.99);
+    check_filter<filter_q15<40>, std::int64_t, 15>(flat, in);
+
+    filter_q15<40> fir{flat};
+    std::int16_t   last{};
+    for (std::size_t i{}; i < 40; i++) {
+        last = fir.value(std::numeric_limits<std::int16_t>::max());
+    }
+    EXPECT_EQ(last, std::numeric_limits<std::int16_t>::max());
+    for (std::size_t i{}; i < 40; i++) {
+        last = fir.value(std::numeric_limits<std::int16_t>::min());
+    }
+    EXPECT_EQ(last, std::numeric_limits<std::int16_t>::min());
+}
+
+TEST(fir_fast_test, q31_matches_reference)
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ using wide = __int128;
+    auto const in            = signal<std::int32_t>(3000);
+    check_filter<filter_q31<63>, wide, 31>(sinc_table<63>(0.1, 1.), in);
+    check_filter<filter_q31<9>, wide, 31>(sinc_table<9>(0.2, 1.), in);
+    check_filter<filter_q31<63>, wide, 31>(sinc_table<63>(0.1, 3.), in);
+    std::array<double, 40> flat{};
+    std::fill(flat.begin(), flat.end(), -0.99);
+    check_filter<filter_q31<40>, wide, 31>(flat, in);
+#else
+    GTEST_SKIP() << "no 128 bit reference";
+#endif
+}
+
+TEST(fir_fast_test, reset)
+{
+    auto const                table = sinc_table<15>(0.1, 1.);
+    filter_q15<15>            fir{table};
+    auto const                in = signal<std::int16_t>(100);
+    std::vector<std::int16_t> first(in.size());
+    std::vector<std::int16_t> second(in.size());
+    fir.process(in, first);
+    fir.reset();
+    fir.process(in, second);
+    EXPECT_EQ(first, second);
+}
+
+TEST(fir_fast_test, time)
+{
+    auto const                table = sinc_table<128>(0.1, 1.);
+    auto const                in    = signal<std::int16_t>(48000);
+    std::vector<std::int16_t> out(in.size());
+    filter_q15<128>           q15{table};
+    auto                      start = std::chrono::high_resolution_clock::now();
+    q15.process(in, out);
+    auto stop = std::chrono::high_resolution_clock::now();
+    std::cout << "q15 fir 128 taps, 48000 samples: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() << " us" << std::endl;
+
+    std::vector<std::int32_t> in31(in.begin(), in.end());
+    std::vector<std::int32_t> out31(in.size());
+    filter_q31<128>           q31{table};
+    start = std::chrono::high_resolution_clock::now();
+    q31.process(in31, out31);
+    stop = std::chrono::high_resolution_clock::now();
+    std::cout << "q31 fir 128 taps, 48000 samples: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() << " us" << std::endl;
+}
@@ -2,9 +2,15 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <cstring>
 #include <iostream>
 #include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
 
 using namespace xitren::math;
 
@@ -219,3 +225,187 @@ TEST(fir_test, custom_mid_size_filter)
     filter.value(5.);
     filter.value(5.);
 }
+
+template <class Filter>
+static void
+check_block(Filter reference, Filter block, std::size_t size, std::size_t step)
+{
+    std::vector<double> in(size);
+    std::vector<double> out(size);
+    for (std::size_t i{}; i < size; i++) {
+        in[i] = std::sin(0.01 * static_cast<double>(i * i)) + static_cast<double>(i % 7) * 0.1;
+    }
+    for (std::size_t done{}; done < size; done += step) {
+        auto const chunk = std::min(step, size - done);
+        EXPECT_EQ(block.process(std::span{in}.subspan(done, chunk), std::span{out}.subspan(done, chunk)), chunk);
+    }
+    for (std::size_t i{}; i < size; i++) {
+        EXPECT_DOUBLE_EQ(reference.value(in[i]), out[i]);
+    }
+}
+
+TEST(fir_test, block_matches_value)
+{
+    check_block(lowpass<20, 20, 250>{}, lowpass<20, 20, 250>{}, 1000, 1000);
+    check_block(lowpass<20, 20, 250>{}, lowpass<20, 20, 250>{}, 1000, 7);
+    check_block(bandpass<62, 20, 60, 250>{}, bandpass<62, 20, 60, 250>{}, 3000, 300);
+    check_block(moving_average<5>{}, moving_average<5>{}, 100, 3);
+    check_block(moving_average<1>{}, moving_average<1>{}, 10, 4);
+}
+
+TEST(fir_test, block_time)
+{
+    constexpr std::size_t size = 4096;
+    lowpass<127, 20, 250> by_value;
+    lowpass<127, 20, 250> by_block;
+    std::vector<double>   in(size);
+    std::vector<double>   out(size);
+    for (std::size_t i{}; i < size; i++) {
+        in[i] = static_cast<double>(i % 17);
+    }
+    double sum{};
+    auto   start = std::chrono::high_resolution_clock::now();
+    for (auto item : in) {
+        sum += by_value.value(item);
+    }
+    auto stop = std::chrono::high_resolution_clock::now();
+    std::cout << "value() 4096 samples, 128 taps: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() << " us" << std::endl;
+    start = std::chrono::high_resolution_clock::now();
+    by_block.process(in, out);
+    stop = std::chrono::high_resolution_clock::now();
+    std::cout << "process() 4096 samples, 128 taps: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() << " us" << std::endl;
+    double block_sum{};
+    for (auto item : out) {
+        block_sum += item;
+    }
+    EXPECT_NEAR(sum, block_sum, 1e-6);
+}
+
+template <std::size_t Order>
+static void
+check_fold(std::array<double, Order> const& table, std::size_t size)
+{
+    filter<Order>       by_value{table};
+    filter<Order>       by_block{table};
+    std::vector<double> in(size);
+    std::vector<double> out(size);
+    for (std::size_t i{}; i < size; i++) {
+        in[i] = std::sin(0.01 * static_cast<double>(i * i)) + static_cast<double>(i % 7) * 0.1;
+    }
+    ASSERT_TRUE(by_value.symmetric());
+    EXPECT_EQ(by_block.process(in, out), size);
+    for (std::size_t i{}; i < size; i++) {
+        double expected{};
+        for (std::size_t k{}; (i + 1 >= Order) && (k < Order); k++) {
+            expected += table[k] * in[i + 1 - Order + k];
+        }
+        auto const folded = by_value.value(in[i]);
+        EXPECT_NEAR(expected, folded, 1e-12) << i;
+        EXPECT_DOUBLE_EQ(folded, out[i]) << i;
+    }
+}
+
+TEST(fir_test, symmetric_fold)
+{
+    EXPECT_TRUE((lowpass<20, 20, 250>{}.symmetric()));
+    EXPECT_TRUE((bandpass<62, 20, 60, 250>{}.symmetric()));
+    EXPECT_TRUE((highpass<40, 20, 250>{}.symmetric()));
+    EXPECT_TRUE((bandstop<40, 20, 60, 250>{}.symmetric()));
+    EXPECT_FALSE((lowpass<21, 20, 250>{}.symmetric()));
+
+    check_fold(lowpass<62, 20, 250>::prepare_table(), 1000);
+    check_fold(lowpass<20, 20, 250>::prepare_table(), 300);
+    check_fold(std::array<double, 8>{1., 2., 3., 4., 4., 3., 2., 1.}, 100);
+    check_fold(std::array<double, 13>{1., -2., 3., 5., 7., 11., 13., 11., 7., 5., 3., -2., 1.}, 100);
+    check_fold(std::array<double, 3>{0.25, 0.5, 0.25}, 20);
+
+    filter<21> changed{lowpass<20, 20, 250>::prepare_table()};
+    changed + filter<21>{std::array<double, 21>{1.}};
+    EXPECT_FALSE(changed.symmetric());
+}
+
+TEST(fir_test, symmetric_time)
+{
+    constexpr std::size_t size   = 4096;
+    auto const            table  = lowpass<128, 20, 250>::prepare_table();
+    auto                  skewed = table;
+    skewed[0] *= 1. + 1e-9;
+    filter<129>         folded{table};
+    filter<129>         direct{skewed};
+    std::vector<double> in(size);
+    std::vector<double> out(size);
+    for (std::size_t i{}; i < size; i++) {
+        in[i] = static_cast<double>(i % 17);
+    }
+    EXPECT_TRUE(folded.symmetric());
+    EXPECT_FALSE(direct.symmetric());
+    for (auto* item : {&folded, &direct}) {
+        double sum{};
+        auto   start = std::chrono::high_resolution_clock::now();
+        for (auto sample : in) {
+            sum += item->value(sample);
+        }
+        auto stop = std::chrono::high_resolution_clock::now();
+        std::cout << (item->symmetric() ? "folded" : "direct") << " value() 4096 samples, 129 taps: "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() << " us, sum "
+                  << sum << std::endl;
+        start = std::chrono::high_resolution_clock::now();
+        item->process(in, out);
+        stop = std::chrono::high_resolution_clock::now();
+        std::cout << (item->symmetric() ? "folded" : "direct") << " process() 4096 samples, 129 taps: "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() << " us"
+                  << std::endl;
+    }
+}
+
+TEST(fir_test, overlap_save_matches_value)
+{
+    static_assert(std::is_base_of_v<overlap_save<512>, lowpass<511, 20, 250>>);
+    static_assert(!std::is_base_of_v<overlap_save<21>, lowpass<20, 20, 250>>);
+
+    constexpr std::size_t size = 5000;
+    std::vector<double>   in(size);
+    std::vector<double>   out(size);
+    for (std::size_t i{}; i < size; i++) {
+        in[i] = std::sin(0.01 * static_cast<double>(i * i)) + static_cast<double>(i % 7) * 0.1;
+    }
+    for (std::size_t step : {size, std::size_t{700}, std::size_t{100}}) {
+        bandpass<511, 20, 60, 250> reference;
+        bandpass<511, 20, 60, 250> block;
+        for (std::size_t done{}; done < size; done += step) {
+            auto const chunk = std::min(step, size - done);
+            block.process(std::span{in}.subspan(done, chunk), std::span{out}.subspan(done, chunk));
+        }
+        for (std::size_t i{}; i < size; i++) {
+            EXPECT_NEAR(reference.value(in[i]), out[i], 1e-9);
+        }
+    }
+}
+
+TEST(fir_test, overlap_save_time)
+{
+    constexpr std::size_t  size = 65536;
+    lowpass<2047, 20, 250> fast;
+    std::vector<double>    in(size);
+    std::vector<double>    out(size);
+    std::vector<double>    direct(size);
+    for (std::size_t i{}; i < size; i++) {
+        in[i] = static_cast<double>(i % 17);
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    fast.process(in, out);
+    auto stop = std::chrono::high_resolution_clock::now();
+    std::cout << "overlap-save 65536 samples, 2048 taps: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() << " us" << std::endl;
+    filter<2048> slow{lowpass<2047, 20, 250>::prepare_table()};
+    start = std::chrono::high_resolution_clock::now();
+    slow.process(in, direct);
+    stop = std::chrono::high_resolution_clock::now();
+    std::cout << "direct 65536 samples, 2048 taps: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() << " us" << std::endl;
+    for (std::size_t i{}; i < size; i += 997) {
+        EXPECT_NEAR(direct[i], out[i], 1e-9);
+    }
+}
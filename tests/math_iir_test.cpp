@@ -0,0 +1,256 @@
+#include <xitren/math/iir.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <numbers>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+using namespace xitren::math;
+
+static constexpr double sampling = 1000.;
+
+static double
+warped(double frequency)
+{
+    return std::tan(std::numbers::pi * frequency / sampling);
+}
+
+template <std::size_t Sections>
+static double
+magnitude(iir_sections<Sections> const& sections, double frequency)
+{
+    return std::abs(biquad_cascade<Sections>{sections}.response(frequency, sampling));
+}
+
+template <std::size_t Sections>
+static void
+expect_stable(iir_sections<Sections> const& sections)
+{
+    for (auto const& item : sections) {
+        // Both roots of 1 + a1 z^-1 + a2 z^-2 inside the unit circle
+        EXPECT_LT(std::abs(item.a2), 1.);
+        EXPECT_LT(std::abs(item.a1), 1. + item.a2);
+    }
+}
+
+static double
+chebyshev_polynomial(std::size_t order, double x)
+{
+    return (std::abs(x) <= 1.) ? std::cos(static_cast<double>(order) * std::acos(x))
+                               : std::cosh(static_cast<double>(order) * std::acosh(std::abs(x)));
+}
+
+TEST(iir_test, butterworth)
+{
+    auto const low  = butterworth<5>::lowpass(100., sampling);
+    auto const high = butterworth<4>::highpass(100., sampling);
+    auto const band = butterworth<3>::bandpass(100., 200., sampling);
+    expect_stable(low);
+    expect_stable(high);
+    expect_stable(band);
+    auto const center = std::sqrt(warped(100.) * warped(200.));
+    auto const width  = warped(200.) - warped(100.);
+    for (double f = 1.; f < sampling / 2; f += 7.) {
+        auto const w = warped(f);
+        EXPECT_NEAR(magnitude(low, f), 1. / std::sqrt(1. + std::pow(w / warped(100.), 10.)), 1e-9) << f;
+        EXPECT_NEAR(magnitude(high, f), 1. / std::sqrt(1. + std::pow(warped(100.) / w, 8.)), 1e-9) << f;
+        auto const band_ratio = (w * w - center * center) / (w * width);
+        EXPECT_NEAR(magnitude(band, f), 1. / std::sqrt(1. + std::pow(band_ratio, 6.)), 1e-9) << f;
+    }
+}
+
+TEST(iir_test, chebyshev)
+{
+    auto const   low  = chebyshev<6>::lowpass(150., sampling, 0.5);
+    auto const   high = chebyshev<5>::highpass(150., sampling, 1.);
+    double const eps6 = std::sqrt(std::pow(10., 0.05) - 1.);
+    double const eps5 = std::sqrt(std::pow(10., 0.1) - 1.);
+    expect_stable(low);
+    expect_stable(high);
+    for (double f = 1.; f < sampling / 2; f += 7.) {
+        auto const w  = warped(f) / warped(150.);
+        auto const t6 = chebyshev_polynomial(6, w);
+        auto const t5 = chebyshev_polynomial(5, 1. / w);
+        EXPECT_NEAR(magnitude(low, f), 1. / std::sqrt(1. + eps6 * eps6 * t6 * t6), 1e-9) << f;
+        EXPECT_NEAR(magnitude(high, f), 1. / std::sqrt(1. + eps5 * eps5 * t5 * t5), 1e-9) << f;
+    }
+    auto const band = chebyshev<4>::bandpass(100., 250., sampling, 1.);
+    expect_stable(band);
+    EXPECT_NEAR(magnitude(band, 100.), 1. / std::sqrt(1. + eps5 * eps5), 1e-9);
+    EXPECT_NEAR(magnitude(band, 250.), 1. / std::sqrt(1. + eps5 * eps5), 1e-9);
+}
+
+TEST(iir_test, elliptic)
+{
+    constexpr double ripple      = 0.5;
+    constexpr double attenuation = 60.;
+    double const     edge        = 1. / std::sqrt(std::pow(10., ripple / 10.));
+    double const     floor       = std::pow(10., -attenuation / 20.);
+
+    auto const low = elliptic<5>::lowpass(100., sampling, ripple, attenuation);
+    expect_stable(low);
+    EXPECT_NEAR(magnitude(low, 100.), edge, 1e-9);
+    EXPECT_NEAR(magnitude(low, 0.), 1., 1e-9);
+    for (double f = 0.; f < 100.; f += 1.) {
+        EXPECT_GE(magnitude(low, f), edge - 1e-9) << f;
+        EXPECT_LE(magnitude(low, f), 1. + 1e-9) << f;
+    }
+    // The stopband starts at the passband edge divided by the selectivity modulus, the stopband ripple touches
+    // the attenuation floor
+    double const k1   = std::sqrt(std::pow(10., ripple / 10.) - 1.) / std::sqrt(std::pow(10., attenuation / 10.) - 1.);
+    double const stop = std::atan(warped(100.) / detail::ellipdeg(5, k1)) * sampling / std::numbers::pi;
+    EXPECT_LT(stop, 170.);
+    double peak{};
+    for (double f = stop; f < sampling / 2; f += 0.25) {
+        peak = std::max(peak, magnitude(low, f));
+    }
+    EXPECT_NEAR(peak, floor, floor * 1e-3);
+
+    auto const even = elliptic<4>::lowpass(100., sampling, ripple, attenuation);
+    expect_stable(even);
+    EXPECT_NEAR(magnitude(even, 0.), edge, 1e-9);
+    EXPECT_NEAR(magnitude(even, 100.), edge, 1e-9);
+
+    auto const high = elliptic<6>::highpass(200., sampling, ripple, attenuation);
+    expect_stable(high);
+    EXPECT_NEAR(magnitude(high, 200.), edge, 1e-9);
+    for (double f = 0.; f < 150.; f += 1.) {
+        EXPECT_LE(magnitude(high, f), floor * (1. + 1e-6)) << f;
+    }
+    for (double f = 200.; f < sampling / 2; f += 1.) {
+        EXPECT_GE(magnitude(high, f), edge - 1e-9) << f;
+    }
+
+    auto const band = elliptic<4>::bandpass(200., 300., sampling, ripple, attenuation);
+    expect_stable(band);
+    EXPECT_NEAR(magnitude(band, 200.), edge, 1e-9);
+    EXPECT_NEAR(magnitude(band, 300.), edge, 1e-9);
+    for (double f = 201.; f < 300.; f += 1.) {
+        EXPECT_GE(magnitude(band, f), edge - 1e-9) << f;
+    }
+    EXPECT_LE(magnitude(band, 100.), floor * (1. + 1e-6));
+    EXPECT_LE(magnitude(band, 450.), floor * (1. + 1e-6));
+}
+
+static std::vector<double>
+signal(std::size_t size)
+{
+    std::vector<double> ret(size);
+    for (std::size_t i{}; i < size; i++) {
+        ret[i] = std::sin(0.05 * static_cast<double>(i)) + 0.3 * std::sin(0.9 * static_cast<double>(i * i % 37));
+    }
+    return ret;
+}
+
+TEST(iir_test, block_matches_value)
+{
+    auto const               sections = elliptic<6>::lowpass(100., sampling, 0.5, 60.);
+    auto const               in       = signal(1000);
+    biquad_cascade<3>        by_value{sections};
+    biquad_cascade<3>        by_block{sections};
+    biquad_cascade<3, float> single{sections};
+    std::vector<double>      out(in.size());
+    for (std::size_t done{}; done < in.size(); done += 77) {
+        auto const count = std::min<std::size_t>(77, in.size() - done);
+        EXPECT_EQ(by_block.process(std::span{in}.subspan(done, count), std::span{out}.subspan(done, count)), count);
+    }
+    for (std::size_t i{}; i < in.size(); i++) {
+        EXPECT_DOUBLE_EQ(by_value.value(in[i]), out[i]);
+        EXPECT_NEAR(single.value(static_cast<float>(in[i])), out[i], 1e-4);
+    }
+    by_value.reset();
+    EXPECT_EQ(by_value.value(0.), 0.);
+}
+
+template <std::size_t Channels, class Type>
+static void
+check_bank(frame_layout layout, std::size_t frames, std::size_t step)
+{
+    auto const                     sections = chebyshev<4>::bandpass(50., 150., sampling, 1.);
+    biquad_bank<4, Channels, Type> bank{sections};
+    std::vector<Type>              in(frames * Channels);
+    std::vector<Type>              out(frames * Channels);
+    std::vector<Type>              block_in(step * Channels);
+    std::vector<Type>              block_out(step * Channels);
+    for (std::size_t f{}; f < frames; f++) {
+        for (std::size_t c{}; c < Channels; c++) {
+            in[f * Channels + c] = static_cast<Type>(std::sin(0.01 * static_cast<double>(f * (c + 1))));
+        }
+    }
+    for (std::size_t done{}; done < frames; done += step) {
+        auto const count = std::min(step, frames - done);
+        auto const index = [layout, count](std::size_t f, std::size_t c) {
+            return (layout == frame_layout::interleaved) ? f * Channels + c : c * count + f;
+        };
+        for (std::size_t f{}; f < count; f++) {
+            for (std::size_t c{}; c < Channels; c++) {
+                block_in[index(f, c)] = in[(done + f) * Channels + c];
+            }
+        }
+        auto const size = count * Channels;
+        ASSERT_EQ(bank.process(std::span{block_in}.first(size), std::span{block_out}.first(size), layout), count);
+        for (std::size_t f{}; f < count; f++) {
+            for (std::size_t c{}; c < Channels; c++) {
+                out[(done + f) * Channels + c] = block_out[index(f, c)];
+            }
+        }
+    }
+    // Double channels run the lane_ops vectors, which may contract into fused multiply-adds unlike the scalar cascade
+    Type const tolerance = std::is_same_v<Type, double> ? Type{1e-12} : Type{};
+    for (std::size_t c{}; c < Channels; c++) {
+        biquad_cascade<4, Type> reference{sections};
+        for (std::size_t f{}; f < frames; f++) {
+            EXPECT_NEAR(reference.value(in[f * Channels + c]), out[f * Channels + c], tolerance) << c << " " << f;
+        }
+    }
+}
+
+TEST(iir_test, bank_matches_cascade)
+{
+    check_bank<64, double>(frame_layout::interleaved, 500, 500);
+    check_bank<64, float>(frame_layout::interleaved, 500, 33);
+    check_bank<13, double>(frame_layout::planar, 300, 100);
+    check_bank<21, float>(frame_layout::planar, 300, 300);
+    check_bank<3, double>(frame_layout::interleaved, 100, 7);
+
+    auto const            sections = butterworth<2>::lowpass(100., sampling);
+    biquad_bank<1, 4>     bank{sections};
+    std::array<double, 4> out{};
+    bank.value(std::array<double, 4>{1., 2., 3., 4.}, out);
+    EXPECT_DOUBLE_EQ(out[1], 2. * out[0]);
+}
+
+TEST(iir_test, time)
+{
+    constexpr std::size_t channels = 128;
+    constexpr std::size_t frames   = 4096;
+    auto const            sections = elliptic<8>::lowpass(100., sampling, 0.5, 60.);
+    std::vector<float>    in(frames * channels);
+    std::vector<float>    out(frames * channels);
+    for (std::size_t i{}; i < in.size(); i++) {
+        in[i] = static_cast<float>(i % 17);
+    }
+    auto bank = std::make_unique<biquad_bank<4, channels, float>>(sections);
+    std::vector<biquad_cascade<4, float>> cascades(channels, biquad_cascade<4, float>{sections});
+
+    auto start = std::chrono::high_resolution_clock::now();
+    bank->process(in, out);
+    auto stop = std::chrono::high_resolution_clock::now();
+    std::cout << "biquad bank 128 channels, 4096 frames, 8th order: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() << " us" << std::endl;
+    start = std::chrono::high_resolution_clock::now();
+    for (std::size_t f{}; f < frames; f++) {
+        for (std::size_t c{}; c < channels; c++) {
+            out[f * channels + c] = cascades[c].value(in[f * channels + c]);
+        }
+    }
+    stop = std::chrono::high_resolution_clock::now();
+    std::cout << "one cascade per channel: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() << " us" << std::endl;
+}
@@ -296,3 +296,267 @@ TEST(matrix_test, matrix_naive_77x77_add_time)
     }
     std::cout << mC[0][0] << std::endl;
 }
+
+template <class Type, std::size_t Rows, std::size_t Columns, std::size_t Batch>
+static void
+fill_sequence(matrix<Type, Rows, Columns, Batch>& m, int seed)
+{
+    for (std::size_t i = 0; i < Rows; i++) {
+        for (std::size_t j = 0; j < Columns; j++) {
+            m.get(i, j) = static_cast<Type>((static_cast<int>(i * Columns + j) * 7 + seed) % 13 - 6);
+        }
+    }
+}
+
+TEST(matrix_big_test, matrix_func_mult_uneven_rests)
+{
+    using loc_type_a = matrix<double, 6, 5, 2>;
+    using loc_type_b = matrix<double, 5, 7, 2>;
+    using loc_type_c = matrix<double, 6, 7, 2>;
+
+    static loc_type_a mA{};
+    static loc_type_b mB{};
+    static loc_type_c mC{};
+    fill_sequence(mA, 1);
+    fill_sequence(mB, 5);
+    mA.mult(mB, mC);
+
+    for (std::size_t i{}; i < 6; i++) {
+        for (std::size_t j{}; j < 7; j++) {
+            double expected{};
+            for (std::size_t k{}; k < 5; k++) {
+                expected += mA.get(i, k) * mB.get(k, j);
+            }
+            EXPECT_EQ(expected, mC.get(i, j));
+        }
+    }
+}
+
+TEST(matrix_big_test, matrix_func_gemm)
+{
+    using loc_type_a = matrix<double, 11, 9, 4>;
+    using loc_type_b = matrix<double, 9, 10, 4>;
+    using loc_type_c = matrix<double, 11, 10, 4>;
+
+    static loc_type_a mA{};
+    static loc_type_b mB{};
+    static loc_type_c mC{};
+    static loc_type_c mC0{};
+    fill_sequence(mA, 2);
+    fill_sequence(mB, 3);
+    fill_sequence(mC, 4);
+    fill_sequence(mC0, 4);
+
+    mA.gemm(2., mB, -3., mC);
+
+    for (std::size_t i{}; i < 11; i++) {
+        for (std::size_t j{}; j < 10; j++) {
+            double expected{};
+            for (std::size_t k{}; k < 9; k++) {
+                expected += mA.get(i, k) * mB.get(k, j);
+            }
+            expected = 2. * expected - 3. * mC0.get(i, j);
+            EXPECT_EQ(expected, mC.get(i, j));
+        }
+    }
+}
+
+TEST(matrix_big_test, matrix_func_elementwise)
+{
+    using loc_type = matrix<int, 19, 21, 8>;
+
+    static loc_type mA{};
+    static loc_type mB{};
+    static loc_type mC{};
+    static loc_type mR{};
+    fill_sequence(mA, 1);
+    fill_sequence(mB, 2);
+    fill_sequence(mC, 3);
+
+    auto check = [&](auto expected) {
+        for (std::size_t i{}; i < 19; i++) {
+            for (std::size_t j{}; j < 21; j++) {
+                EXPECT_EQ(expected(i, j), mR.get(i, j));
+            }
+        }
+    };
+
+    mA.scale(3, mR);
+    check([&](std::size_t i, std::size_t j) { return 3 * mA.get(i, j); });
+    mA.axpy(-2, mB, mR);
+    check([&](std::size_t i, std::size_t j) { return -2 * mA.get(i, j) + mB.get(i, j); });
+    mA.hadamard(mB, mR);
+    check([&](std::size_t i, std::size_t j) { return mA.get(i, j) * mB.get(i, j); });
+    mA.fma(mB, mC, mR);
+    check([&](std::size_t i, std::size_t j) { return mA.get(i, j) * mB.get(i, j) + mC.get(i, j); });
+    mA.sub(mB, mR);
+    check([&](std::size_t i, std::size_t j) { return mA.get(i, j) - mB.get(i, j); });
+}
+
+TEST(matrix_big_test, matrix_func_row_major)
+{
+    using loc_type = matrix<int, 19, 21, 8>;
+
+    loc_type::init_type data{};
+    for (std::size_t i{}; i < data.size(); i++) {
+        data[i] = static_cast<int>(i);
+    }
+    static loc_type mA{data};
+    for (std::size_t i{}; i < 19; i++) {
+        for (std::size_t j{}; j < 21; j++) {
+            EXPECT_EQ(data[i * 21 + j], mA.get(i, j));
+        }
+    }
+
+    std::size_t visited{};
+    mA.for_each([&](std::size_t row, std::size_t column, int const& item) {
+        EXPECT_EQ(&item, &mA.get(row, column));
+        visited++;
+    });
+    EXPECT_EQ(visited, data.size());
+    EXPECT_EQ(data, mA.row_major());
+}
+
+TEST(matrix_big_test, matrix_func_mult_edge_zones)
+{
+    using loc_type_a = matrix<double, 37, 35, 8>;
+    using loc_type_b = matrix<double, 35, 41, 8>;
+    using loc_type_c = matrix<double, 37, 41, 8>;
+
+    static loc_type_a mA{};
+    static loc_type_b mB{};
+    static loc_type_c mC{};
+    static loc_type_c mP{};
+    fill_sequence(mA, 3);
+    fill_sequence(mB, 7);
+    mA.mult(mB, mC);
+    fill_sequence(mP, 1);
+    mA.mult_padded(mB, mP);
+
+    for (std::size_t i{}; i < 37; i++) {
+        for (std::size_t j{}; j < 41; j++) {
+            double expected{};
+            for (std::size_t k{}; k < 35; k++) {
+                expected += mA.get(i, k) * mB.get(k, j);
+            }
+            EXPECT_EQ(expected, mC.get(i, j));
+            EXPECT_EQ(expected, mP.get(i, j));
+        }
+    }
+
+    static loc_type_c mG{};
+    static loc_type_c mG0{};
+    fill_sequence(mG, 2);
+    fill_sequence(mG0, 2);
+    mA.gemm_padded(0.5, mB, 2., mG);
+    for (std::size_t i{}; i < 37; i++) {
+        for (std::size_t j{}; j < 41; j++) {
+            EXPECT_EQ(0.5 * mC.get(i, j) + 2. * mG0.get(i, j), mG.get(i, j));
+        }
+    }
+}
+
+TEST(matrix_test, matrix_hybrid_257x257_mult_time)
+{
+    using loc_type_odd  = matrix<double, 257, 257, 64>;
+    using loc_type_even = matrix<double, 256, 256, 64>;
+
+    static auto mA = loc_type_odd::get_rand_matrix(1);
+    static auto mB = loc_type_odd::get_rand_matrix(2);
+    static auto mE = loc_type_even::get_rand_matrix(1);
+    static auto mF = loc_type_even::get_rand_matrix(2);
+
+    static loc_type_odd  mC{};
+    static loc_type_even mG{};
+    auto                 time = [](auto callback) {
+        auto start = std::chrono::high_resolution_clock::now();
+        callback();
+        auto stop = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(stop - start).count();
+    };
+    std::cout << "256x256: " << time([&] { mE.mult(mF, mG); }) << " ms" << std::endl;
+    std::cout << "257x257: " << time([&] { mA.mult(mB, mC); }) << " ms" << std::endl;
+    std::cout << "257x257 padded: " << time([&] { mA.mult_padded(mB, mC); }) << " ms" << std::endl;
+}
+
+TEST(matrix_big_test, matrix_func_outer_ger)
+{
+    using loc_type = matrix<int, 19, 21, 8>;
+
+    static loc_type     mA{};
+    static loc_type     mR{};
+    std::array<int, 19> x{};
+    std::array<int, 21> y{};
+    fill_sequence(mA, 1);
+    for (std::size_t i{}; i < x.size(); i++) {
+        x[i] = static_cast<int>(i * 3) - 20;
+    }
+    for (std::size_t j{}; j < y.size(); j++) {
+        y[j] = static_cast<int>(j * j) - 7;
+    }
+
+    loc_type::outer(x, y, mR);
+    for (std::size_t i{}; i < 19; i++) {
+        for (std::size_t j{}; j < 21; j++) {
+            EXPECT_EQ(x[i] * y[j], mR.get(i, j));
+        }
+    }
+    mA.ger(-3, x, y, mR);
+    for (std::size_t i{}; i < 19; i++) {
+        for (std::size_t j{}; j < 21; j++) {
+            EXPECT_EQ(mA.get(i, j) - 3 * x[i] * y[j], mR.get(i, j));
+        }
+    }
+    mR = mA;
+    mR.ger(2, x, y, mR);
+    for (std::size_t i{}; i < 19; i++) {
+        for (std::size_t j{}; j < 21; j++) {
+            EXPECT_EQ(mA.get(i, j) + 2 * x[i] * y[j], mR.get(i, j));
+        }
+    }
+}
+
+TEST(matrix_big_test, matrix_func_kron)
+{
+    using left_type  = matrix<int, 5, 7, 4>;
+    using right_type = matrix<int, 3, 6, 4>;
+    using ret_type   = matrix<int, 15, 42, 4>;
+
+    static left_type  mA{};
+    static right_type mB{};
+    static ret_type   mR{};
+    fill_sequence(mA, 1);
+    fill_sequence(mB, 2);
+    mA.kron(mB, mR);
+    for (std::size_t i{}; i < 15; i++) {
+        for (std::size_t j{}; j < 42; j++) {
+            EXPECT_EQ(mA.get(i / 3, j / 6) * mB.get(i % 3, j % 6), mR.get(i, j));
+        }
+    }
+}
+
+TEST(matrix_test, matrix_kron_2048x2048_time)
+{
+    using left_type  = matrix<double, 64, 64, 64>;
+    using right_type = matrix<double, 32, 32, 64>;
+    using ret_type   = matrix<double, 2048, 2048, 64>;
+
+    static auto     mA = left_type::get_rand_matrix(1);
+    static auto     mB = right_type::get_rand_matrix(2);
+    static ret_type mR{};
+    mA.kron(mB, mR);
+    auto start = std::chrono::high_resolution_clock::now();
+    mA.kron(mB, mR);
+    auto stop = std::chrono::high_resolution_clock::now();
+    std::cout << "kron 2048x2048: " << std::chrono::duration_cast<std::chrono::milliseconds>(stop - start).count()
+              << " ms" << std::endl;
+    start = std::chrono::high_resolution_clock::now();
+    for (std::size_t i{}; i < 2048; i++) {
+        for (std::size_t j{}; j < 2048; j++) {
+            mR.get(i, j) = mA.get(i / 32, j / 32) * mB.get(i % 32, j % 32);
+        }
+    }
+    stop = std::chrono::high_resolution_clock::now();
+    std::cout << "kron 2048x2048 through get: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(stop - start).count() << " ms" << std::endl;
+}
@@ -0,0 +1,112 @@
+#include <xitren/math/matrix.hpp>
+#include <xitren/math/matrix_bool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+using namespace xitren::math;
+
+template <std::size_t Rows, std::size_t Columns>
+static matrix_bool<Rows, Columns>
+random_bool(std::uint64_t seed, std::uint64_t density)
+{
+    matrix_bool<Rows, Columns> ret{};
+    for (std::size_t i{}; i < Rows; i++) {
+        for (std::size_t j{}; j < Columns; j++) {
+            ret.set(i, j, (counter_random::bits(seed, i * Columns + j) % density) == 0);
+        }
+    }
+    return ret;
+}
+
+TEST(matrix_bool_test, pack)
+{
+    static matrix<std::uint8_t, 70, 130, 16> source{};
+    source.get(0, 0)    = 1;
+    source.get(3, 64)   = 7;
+    source.get(69, 129) = 255;
+
+    matrix_bool<70, 130> const packed{source};
+    EXPECT_TRUE(packed.get(0, 0));
+    EXPECT_TRUE(packed.get(3, 64));
+    EXPECT_TRUE(packed.get(69, 129));
+    EXPECT_FALSE(packed.get(3, 63));
+    EXPECT_EQ(packed.count(), 3);
+    EXPECT_TRUE(packed.transpose().get(129, 69));
+}
+
+TEST(matrix_bool_test, mult_and_count)
+{
+    auto const mA = random_bool<70, 130>(1, 9);
+    auto const mB = random_bool<130, 90>(2, 9);
+
+    matrix_bool<70, 90> mC{};
+    mA.mult(mB, mC);
+    static matrix<int, 70, 90, 16> mN{};
+    mA.count(mB, mN);
+
+    for (std::size_t i{}; i < 70; i++) {
+        for (std::size_t j{}; j < 90; j++) {
+            int paths{};
+            for (std::size_t k{}; k < 130; k++) {
+                paths += (mA.get(i, k) && mB.get(k, j)) ? 1 : 0;
+            }
+            EXPECT_EQ(paths, mN.get(i, j));
+            EXPECT_EQ(paths != 0, mC.get(i, j));
+        }
+    }
+}
+
+TEST(matrix_bool_test, closure)
+{
+    // A chain 0 -> 1 -> ... -> 99 and a separate cycle 100 -> 101 -> 102 -> 100
+    matrix_bool<103, 103> graph{};
+    for (std::size_t i{}; i + 1 < 100; i++) {
+        graph.set(i, i + 1);
+    }
+    graph.set(100, 101);
+    graph.set(101, 102);
+    graph.set(102, 100);
+
+    auto const reach = graph.closure();
+    for (std::size_t i{}; i < 100; i++) {
+        for (std::size_t j{}; j < 103; j++) {
+            EXPECT_EQ(j > i && j < 100, reach.get(i, j));
+        }
+    }
+    for (std::size_t i{100}; i < 103; i++) {
+        for (std::size_t j{}; j < 103; j++) {
+            EXPECT_EQ(j >= 100, reach.get(i, j));
+        }
+    }
+    EXPECT_TRUE(graph.closure(true).get(5, 5));
+    EXPECT_FALSE(reach.get(5, 5));
+}
+
+TEST(matrix_bool_test, matrix_bool_512_mult_time)
+{
+    auto const mA = random_bool<512, 512>(3, 16);
+    auto const mB = random_bool<512, 512>(4, 16);
+
+    static matrix<int, 512, 512, 64> mAb{};
+    static matrix<int, 512, 512, 64> mBb{};
+    static matrix<int, 512, 512, 64> mCb{};
+    mAb.for_each([&](std::size_t i, std::size_t j, int& item) { item = mA.get(i, j); });
+    mBb.for_each([&](std::size_t i, std::size_t j, int& item) { item = mB.get(i, j); });
+
+    matrix_bool<512, 512> mC{};
+    auto                  time = [](auto callback) {
+        auto start = std::chrono::high_resolution_clock::now();
+        callback();
+        auto stop = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count();
+    };
+    std::cout << "Bit-packed 512x512: " << time([&] { mA.mult(mB, mC); }) << " us" << std::endl;
+    std::cout << "int 512x512: " << time([&] { mAb.mult(mBb, mCb); }) << " us" << std::endl;
+    std::cout << "Storage " << sizeof(mC) << " vs " << sizeof(mCb) << " bytes" << std::endl;
+    EXPECT_EQ(mC.get(7, 11), mCb.get(7, 11) != 0);
+}
@@ -0,0 +1,81 @@
+#include <xitren/math/matrix_complex.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <complex>
+#include <iostream>
+#include <vector>
+
+using namespace xitren::math;
+
+template <class Type, std::size_t Rows, std::size_t Inner, std::size_t Columns, std::size_t Batch>
+static void
+check_naive(matrix_complex<Type, Rows, Inner, Batch> const& a, matrix_complex<Type, Inner, Columns, Batch> const& b,
+            matrix_complex<Type, Rows, Columns, Batch> const& c)
+{
+    std::vector<std::complex<Type>> ra(Rows * Inner);
+    std::vector<std::complex<Type>> rb(Inner * Columns);
+    for (std::size_t i{}; i < Rows; i++) {
+        for (std::size_t k{}; k < Inner; k++) {
+            ra[i * Inner + k] = a.get(i, k);
+        }
+    }
+    for (std::size_t k{}; k < Inner; k++) {
+        for (std::size_t j{}; j < Columns; j++) {
+            rb[k * Columns + j] = b.get(k, j);
+        }
+    }
+    for (std::size_t i{}; i < Rows; i++) {
+        for (std::size_t j{}; j < Columns; j++) {
+            std::complex<Type> sum{};
+            for (std::size_t k{}; k < Inner; k++) {
+                sum += ra[i * Inner + k] * rb[k * Columns + j];
+            }
+            EXPECT_NEAR(sum.real(), c.get(i, j).real(), 1e-9);
+            EXPECT_NEAR(sum.imag(), c.get(i, j).imag(), 1e-9);
+        }
+    }
+}
+
+TEST(matrix_complex_test, access)
+{
+    static matrix_complex<double, 5, 3, 2> mA{};
+    mA.set(4, 2, {1., -2.});
+    EXPECT_EQ(mA.get(4, 2), std::complex<double>(1., -2.));
+    EXPECT_EQ(mA.real().get(4, 2), 1.);
+    EXPECT_EQ(mA.imag().get(4, 2), -2.);
+
+    mA.conj(mA);
+    EXPECT_EQ(mA.get(4, 2), std::complex<double>(1., 2.));
+}
+
+TEST(matrix_complex_test, mult_3m_and_4m)
+{
+    static auto const mA = matrix_complex<double, 37, 45, 8>::get_rand_matrix(1);
+    static auto const mB = matrix_complex<double, 45, 21, 8>::get_rand_matrix(3);
+    static matrix_complex<double, 37, 21, 8> mC{};
+    static matrix_complex<double, 37, 21, 8> mD{};
+
+    mA.mult(mB, mC);
+    check_naive(mA, mB, mC);
+    mA.mult_4m(mB, mD);
+    check_naive(mA, mB, mD);
+}
+
+TEST(matrix_complex_test, matrix_complex_512_mult_time)
+{
+    static auto mA = matrix_complex<double, 512, 512, 64>::get_rand_matrix(5);
+    static auto mB = matrix_complex<double, 512, 512, 64>::get_rand_matrix(7);
+    static matrix_complex<double, 512, 512, 64> mC{};
+
+    auto time = [](auto callback) {
+        auto start = std::chrono::high_resolution_clock::now();
+        callback();
+        auto stop = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count();
+    };
+    std::cout << "3M 512x512: " << time([&] { mA.mult(mB, mC); }) << " us" << std::endl;
+    std::cout << "4M 512x512: " << time([&] { mA.mult_4m(mB, mC); }) << " us" << std::endl;
+    std::cout << "Real 512x512: " << time([&] { mA.real().mult(mB.real(), mC.real()); }) << " us" << std::endl;
+}
@@ -0,0 +1,99 @@
+#include <xitren/math/matrix.hpp>
+#include <xitren/math/matrix_eigen.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <numbers>
+
+using namespace xitren::math;
+
+template <std::size_t Size, std::size_t Batch>
+static void
+check_decomposition(matrix<double, Size, Size, Batch> const& a, symmetric_eigen<double, Size, Batch> const& eigen,
+                    double tolerance)
+{
+    auto const& vectors = eigen.vectors();
+    auto const& values  = eigen.values();
+    auto        av      = std::make_unique<matrix<double, Size, Size, Batch>>();
+    a.mult(vectors, *av);
+    for (std::size_t i{}; i < Size; i++) {
+        for (std::size_t j{}; j < Size; j++) {
+            EXPECT_NEAR(av->get(i, j), values[j] * vectors.get(i, j), tolerance);
+        }
+    }
+    auto vt  = std::make_unique<matrix<double, Size, Size, Batch>>();
+    auto vtv = std::make_unique<matrix<double, Size, Size, Batch>>();
+    vectors.transpose(*vt);
+    vt->mult(vectors, *vtv);
+    for (std::size_t i{}; i < Size; i++) {
+        for (std::size_t j{}; j < Size; j++) {
+            EXPECT_NEAR(vtv->get(i, j), i == j ? 1. : 0., tolerance);
+        }
+        if (i > 0) {
+            EXPECT_LE(values[i - 1], values[i]);
+        }
+    }
+}
+
+TEST(matrix_eigen_test, random_symmetric)
+{
+    using loc_type = matrix<double, 100, 100, 16>;
+    auto mA        = std::make_unique<loc_type>(loc_type::get_rand_matrix(21));
+    mA->for_each([&mA](std::size_t row, std::size_t column, double& item) {
+        if (column > row) {
+            item = mA->get(column, row);
+        }
+    });
+    symmetric_eigen<double, 100, 16> const eigen{*mA};
+    check_decomposition(*mA, eigen, 1e-12);
+}
+
+TEST(matrix_eigen_test, laplacian)
+{
+    // Second difference matrix, eigenvalues 2 - 2 cos(k pi / (n + 1))
+    constexpr std::size_t size = 77;
+    static matrix<double, size, size, 8> mA{};
+    mA.for_each([](std::size_t row, std::size_t column, double& item) {
+        item = (row == column) ? 2. : (((row == column + 1) || (column == row + 1)) ? -1. : 0.);
+    });
+    symmetric_eigen<double, size, 8> const eigen{mA};
+    for (std::size_t k{}; k < size; k++) {
+        EXPECT_NEAR(eigen.values()[k], 2. - 2. * std::cos(static_cast<double>(k + 1) * std::numbers::pi / (size + 1)),
+                    1e-13);
+    }
+    check_decomposition(mA, eigen, 1e-13);
+}
+
+TEST(matrix_eigen_test, repeated_eigenvalues)
+{
+    // 2 * I + ones, eigenvalue 2 is repeated 69 times, which deflates almost everything
+    static matrix<double, 70, 70, 8> mA{};
+    mA.for_each([](std::size_t row, std::size_t column, double& item) { item = (row == column) ? 3. : 1.; });
+    symmetric_eigen<double, 70, 8> const eigen{mA};
+    for (std::size_t k{}; k + 1 < 70; k++) {
+        EXPECT_NEAR(eigen.values()[k], 2., 1e-12);
+    }
+    EXPECT_NEAR(eigen.values()[69], 72., 1e-12);
+    check_decomposition(mA, eigen, 1e-12);
+}
+
+TEST(matrix_eigen_test, eigen_256_time)
+{
+    using loc_type = matrix<double, 256, 256, 32>;
+    auto mA        = std::make_unique<loc_type>(loc_type::get_rand_matrix(22));
+    mA->for_each([&mA](std::size_t row, std::size_t column, double& item) {
+        if (column > row) {
+            item = mA->get(column, row);
+        }
+    });
+    auto start = std::chrono::high_resolution_clock::now();
+    auto eigen = std::make_unique<symmetric_eigen<double, 256, 32>>(*mA);
+    auto stop  = std::chrono::high_resolution_clock::now();
+    std::cout << "Symmetric eigen 256x256: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() << " us" << std::endl;
+    check_decomposition(*mA, *eigen, 1e-11);
+}
@@ -0,0 +1,69 @@
+#include <xitren/math/matrix_memory.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+using namespace xitren::math;
+
+TEST(matrix_memory_test, numa_nodes)
+{
+    auto const nodes = numa_nodes();
+    ASSERT_FALSE(nodes.empty());
+    EXPECT_TRUE(std::is_sorted(nodes.begin(), nodes.end()));
+}
+
+TEST(matrix_memory_test, default_interleaves)
+{
+    EXPECT_EQ(memory_policy{}.placement, numa_placement::interleave);
+}
+
+TEST(matrix_memory_test, zeroed_and_aligned)
+{
+    using loc_type = matrix<double, 300, 270, 32>;
+    for (auto placement : {numa_placement::first_touch, numa_placement::interleave, numa_placement::bind}) {
+        for (bool huge_pages : {false, true}) {
+            auto m = make_matrix<loc_type>({placement, huge_pages, numa_nodes().front()});
+            if (huge_pages) {
+                EXPECT_EQ(reinterpret_cast<std::uintptr_t>(m.get()) % (std::size_t{2} << 20), 0U);
+            }
+            m->for_each([](std::size_t, std::size_t, double const& item) { EXPECT_EQ(item, 0.0); });
+        }
+    }
+}
+
+TEST(matrix_memory_test, mult)
+{
+    using loc_type = matrix<double, 200, 200, 32>;
+    auto a         = make_matrix<loc_type>({numa_placement::interleave, true});
+    auto b         = make_matrix<loc_type>();
+    auto c         = make_matrix<loc_type>({numa_placement::first_touch, true});
+    auto expected  = std::make_unique<loc_type>();
+    *a             = loc_type::get_rand_matrix(1);
+    *b             = loc_type::get_rand_matrix(2);
+    a->mult(*b, *c);
+    loc_type::get_rand_matrix(1).mult(*b, *expected);
+    expected->for_each([&c](std::size_t row, std::size_t column, double const& item) {
+        EXPECT_DOUBLE_EQ(item, c->get(row, column));
+    });
+}
+
+TEST(matrix_memory_test, mult_time)
+{
+    using loc_type = matrix<double, 1024, 1024, 32>;
+    for (bool huge_pages : {false, true}) {
+        auto a = make_matrix<loc_type>({numa_placement::interleave, huge_pages});
+        auto b = make_matrix<loc_type>({numa_placement::interleave, huge_pages});
+        auto c = make_matrix<loc_type>({numa_placement::interleave, huge_pages});
+        a->for_each([](std::size_t row, std::size_t column, double& item) { item = double((row * 7 + column) % 13); });
+        b->for_each([](std::size_t row, std::size_t column, double& item) { item = double((row + column * 5) % 11); });
+
+        auto begin = std::chrono::high_resolution_clock::now();
+        a->mult(*b, *c);
+        auto end = std::chrono::high_resolution_clock::now();
+        std::cout << "1024x1024 " << (huge_pages ? "huge pages: " : "4k pages: ")
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << " ms" << std::endl;
+    }
+}
@@ -0,0 +1,56 @@
+#include <xitren/math/matrix.hpp>
+#include <xitren/math/matrix_ooc.hpp>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <iostream>
+#include <limits>
+
+using namespace xitren::math;
+
+TEST(matrix_ooc_test, mult_matches_in_memory)
+{
+    using loc_type_a = matrix<double, 24, 40, 8>;
+    using loc_type_b = matrix<double, 40, 16, 8>;
+    using loc_type_c = matrix<double, 24, 16, 8>;
+    using file_type  = tile_file<double, 8>;
+
+    auto const dir = std::filesystem::temp_directory_path() / "xitren_math_ooc_test";
+    std::filesystem::create_directories(dir);
+
+    static auto       mA = loc_type_a::get_rand_matrix(1);
+    static auto       mB = loc_type_b::get_rand_matrix(2);
+    static loc_type_c mC{};
+    mA.mult(mB, mC);
+
+    file_type const fA{dir / "a.tiles", 3, 5};
+    file_type const fB{dir / "b.tiles", 5, 2};
+    file_type const fC{dir / "c.tiles", 3, 2};
+    fA.store(mA);
+    fB.store(mB);
+
+    // From the smallest budget (single tile blocks and panels) to the whole output in memory
+    std::size_t last_reads{std::numeric_limits<std::size_t>::max()};
+    for (std::size_t tiles : {6, 10, 14, 30}) {
+        auto const reads = ooc_mult(fA, fB, fC, tiles * file_type::tile_bytes);
+        EXPECT_LE(reads, last_reads) << "budget " << tiles;
+        last_reads = reads;
+        static loc_type_c mR{};
+        fC.load(mR);
+        for (std::size_t i{}; i < 24; i++) {
+            for (std::size_t j{}; j < 16; j++) {
+                EXPECT_NEAR(mC.get(i, j), mR.get(i, j), 1e-12) << "budget " << tiles;
+            }
+        }
+    }
+
+    // Single tile blocks read one A and one B tile per product, the whole output reads every tile once
+    EXPECT_EQ(3 * 2 * 5 * 2, ooc_mult(fA, fB, fC, 6 * file_type::tile_bytes));
+    EXPECT_EQ(3 * 5 + 5 * 2, last_reads);
+
+    EXPECT_THROW(ooc_mult(fA, fB, fC, 5 * file_type::tile_bytes), std::invalid_argument);
+    EXPECT_THROW((file_type{dir / "a.tiles", 3, 4}), std::invalid_argument);
+    EXPECT_THROW(ooc_mult(fA, fA, fC, 30 * file_type::tile_bytes), std::invalid_argument);
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,129 @@
+#include <xitren/math/matrix.hpp>
+#include <xitren/math/matrix_qr.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+
+using namespace xitren::math;
+
+TEST(matrix_qr_test, factors)
+{
+    using a_type   = matrix<double, 75, 45, 8>;
+    static auto mA = a_type::get_rand_matrix(11);
+
+    qr<double, 75, 45, 8> const factor{mA};
+    static a_type                       mQ{};
+    static matrix<double, 45, 45, 8>    mR{};
+    factor.q(mQ);
+    factor.r(mR);
+
+    for (std::size_t i{}; i < 45; i++) {
+        for (std::size_t j{}; j < i; j++) {
+            EXPECT_EQ(mR.get(i, j), 0.);
+        }
+    }
+    // Q * R = A
+    static a_type mQR{};
+    mQ.mult(mR, mQR);
+    for (std::size_t i{}; i < 75; i++) {
+        for (std::size_t j{}; j < 45; j++) {
+            EXPECT_NEAR(mA.get(i, j), mQR.get(i, j), 1e-12);
+        }
+    }
+    // Q^T * Q = I
+    for (std::size_t i{}; i < 45; i++) {
+        for (std::size_t j{}; j < 45; j++) {
+            double sum{};
+            for (std::size_t k{}; k < 75; k++) {
+                sum += mQ.get(k, i) * mQ.get(k, j);
+            }
+            EXPECT_NEAR(sum, i == j ? 1. : 0., 1e-12);
+        }
+    }
+}
+
+TEST(matrix_qr_test, lstsq_exact)
+{
+    static auto mA = matrix<double, 40, 33, 4>::get_rand_matrix(12);
+    static auto mX = matrix<double, 33, 3, 4>::get_rand_matrix(13);
+    static matrix<double, 40, 3, 4> mB{};
+    mA.mult(mX, mB);
+
+    static matrix<double, 33, 3, 4> mS{};
+    lstsq(mA, mB, mS);
+    for (std::size_t i{}; i < 33; i++) {
+        for (std::size_t j{}; j < 3; j++) {
+            EXPECT_NEAR(mX.get(i, j), mS.get(i, j), 1e-9);
+        }
+    }
+}
+
+TEST(matrix_qr_test, lstsq_default_batch)
+{
+    // matrix<double, 70, 37> picks 32 x 32 tiles, so QR runs a full and a partial panel
+    static auto mA = matrix<double, 70, 37>::get_rand_matrix(15);
+    static auto mX = matrix<double, 37, 2>::get_rand_matrix(16);
+    static matrix<double, 70, 2> mB{};
+    mB.for_each([](std::size_t row, std::size_t column, double& item) {
+        for (std::size_t k{}; k < 37; k++) {
+            item += mA.get(row, k) * mX.get(k, column);
+        }
+    });
+
+    static matrix<double, 37, 2> mS{};
+    lstsq(mA, mB, mS);
+    for (std::size_t i{}; i < 37; i++) {
+        for (std::size_t j{}; j < 2; j++) {
+            EXPECT_NEAR(mX.get(i, j), mS.get(i, j), 1e-9);
+        }
+    }
+}
+
+TEST(matrix_qr_test, lstsq_polynomial_fit)
+{
+    // y = 1 - 2 t + 0.5 t^2 sampled with a symmetric +-0.01 disturbance, which the fit averages out
+    constexpr std::size_t samples = 101;
+    static matrix<double, samples, 3, 2> mA{};
+    static matrix<double, samples, 2, 2> mB{};
+    for (std::size_t i{}; i < samples; i++) {
+        double const t = -1. + 2. * static_cast<double>(i) / (samples - 1);
+        mA.get(i, 0)   = 1.;
+        mA.get(i, 1)   = t;
+        mA.get(i, 2)   = t * t;
+        mB.get(i, 0)   = 1. - 2. * t + 0.5 * t * t;
+        mB.get(i, 1)   = mB.get(i, 0) + ((i % 2) != 0 ? 0.01 : -0.01) * (i == samples - 1 ? 0. : 1.);
+    }
+    static matrix<double, 3, 2, 2> mC{};
+    lstsq(mA, mB, mC);
+    EXPECT_NEAR(mC.get(0, 0), 1., 1e-12);
+    EXPECT_NEAR(mC.get(1, 0), -2., 1e-12);
+    EXPECT_NEAR(mC.get(2, 0), 0.5, 1e-12);
+    EXPECT_NEAR(mC.get(0, 1), 1., 1e-3);
+    EXPECT_NEAR(mC.get(1, 1), -2., 1e-3);
+    EXPECT_NEAR(mC.get(2, 1), 0.5, 1e-3);
+}
+
+TEST(matrix_qr_test, qr_256_time)
+{
+    using a_type = matrix<double, 256, 256, 32>;
+    auto mA      = std::make_unique<a_type>(a_type::get_rand_matrix(14));
+
+    auto start  = std::chrono::high_resolution_clock::now();
+    auto factor = std::make_unique<qr<double, 256, 256, 32>>(*mA);
+    auto stop   = std::chrono::high_resolution_clock::now();
+    std::cout << "QR 256x256: " << std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count()
+              << " us" << std::endl;
+
+    auto mR = std::make_unique<matrix<double, 256, 256, 32>>();
+    factor->r(*mR);
+    // |R(0, 0)| is the norm of the first column
+    double norm{};
+    for (std::size_t i{}; i < 256; i++) {
+        norm += mA->get(i, 0) * mA->get(i, 0);
+    }
+    EXPECT_NEAR(std::abs(mR->get(0, 0)), std::sqrt(norm), 1e-9);
+}
@@ -0,0 +1,79 @@
+#include <xitren/math/matrix_shm.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#if defined(__unix__)
+
+using namespace xitren::math;
+
+template <std::size_t Rows, std::size_t Inner, std::size_t Columns, std::size_t Batch>
+static void
+check_shm(std::size_t processes)
+{
+    using a_type   = matrix<double, Rows, Inner, Batch>;
+    using b_type   = matrix<double, Inner, Columns, Batch>;
+    using ret_type = matrix<double, Rows, Columns, Batch>;
+
+    auto a        = std::make_unique<a_type>(a_type::get_rand_matrix(1));
+    auto b        = std::make_unique<b_type>(b_type::get_rand_matrix(2));
+    auto expected = std::make_unique<ret_type>();
+    auto result   = std::make_unique<ret_type>();
+    a->mult(*b, *expected);
+    shm_mult(*a, *b, *result, processes);
+    expected->for_each([&result](std::size_t row, std::size_t column, double const& item) {
+        EXPECT_NEAR(item, result->get(row, column), 1e-9);
+    });
+}
+
+TEST(matrix_shm_test, uneven_shapes)
+{
+    check_shm<300, 260, 270, 32>(3);
+    check_shm<70, 45, 33, 16>(2);
+}
+
+TEST(matrix_shm_test, more_processes_than_tile_rows)
+{
+    check_shm<40, 64, 50, 16>(8);
+}
+
+TEST(matrix_shm_test, single_process)
+{
+    check_shm<128, 96, 64, 32>(1);
+}
+
+TEST(matrix_shm_test, other_thread_runs_in_process)
+{
+    // fork() is not used while another thread exists, the product is still complete
+    std::promise<void> stop;
+    std::thread        other{[done = stop.get_future()] { done.wait(); }};
+    check_shm<70, 45, 33, 16>(3);
+    stop.set_value();
+    other.join();
+}
+
+TEST(matrix_shm_test, mult_time)
+{
+    using loc_type = matrix<double, 512, 512, 32>;
+    auto a         = std::make_unique<loc_type>(loc_type::get_rand_matrix(3));
+    auto b         = std::make_unique<loc_type>(loc_type::get_rand_matrix(4));
+    auto c         = std::make_unique<loc_type>();
+
+    auto begin = std::chrono::high_resolution_clock::now();
+    shm_mult(*a, *b, *c, 4);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "shm_mult 512x512, 4 processes: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count() << " us" << std::endl;
+    begin = std::chrono::high_resolution_clock::now();
+    a->mult(*b, *c);
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "mult 512x512: " << std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count()
+              << " us" << std::endl;
+}
+
+#endif
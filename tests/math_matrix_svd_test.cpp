@@ -0,0 +1,100 @@
+#include <xitren/math/matrix.hpp>
+#include <xitren/math/matrix_qr.hpp>
+#include <xitren/math/matrix_svd.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+
+using namespace xitren::math;
+
+TEST(matrix_svd_test, decaying_spectrum)
+{
+    constexpr std::size_t rows    = 300;
+    constexpr std::size_t columns = 200;
+    constexpr std::size_t inner   = 40;
+    using left_type               = matrix<double, rows, inner, 16>;
+    using right_type              = matrix<double, columns, inner, 16>;
+    using a_type                  = matrix<double, rows, columns, 16>;
+
+    // A = X * diag(sigma) * Y^T with orthonormal X, Y and sigma_i = 2^-i
+    auto mX = std::make_unique<left_type>(left_type::get_rand_matrix(31));
+    auto mY = std::make_unique<right_type>(right_type::get_rand_matrix(32));
+    qr<double, rows, inner, 16>{*mX}.q(*mX);
+    qr<double, columns, inner, 16>{*mY}.q(*mY);
+    mX->for_each([](std::size_t, std::size_t column, double& item) { item *= std::ldexp(1., -static_cast<int>(column)); });
+    auto mYt = std::make_unique<matrix<double, inner, columns, 16>>();
+    auto mA  = std::make_unique<a_type>();
+    mY->transpose(*mYt);
+    mX->mult(*mYt, *mA);
+
+    truncated_svd<double, rows, columns, 6, 16> const svd{*mA};
+    for (std::size_t i{}; i < 6; i++) {
+        EXPECT_NEAR(svd.values()[i], std::ldexp(1., -static_cast<int>(i)), 1e-10);
+    }
+    // A * v_i = sigma_i * u_i and orthonormal columns
+    auto mAv = std::make_unique<matrix<double, rows, 6, 16>>();
+    mA->mult(svd.v(), *mAv);
+    for (std::size_t i{}; i < rows; i++) {
+        for (std::size_t j{}; j < 6; j++) {
+            EXPECT_NEAR(mAv->get(i, j), svd.values()[j] * svd.u().get(i, j), 1e-10);
+        }
+    }
+    for (std::size_t i{}; i < 6; i++) {
+        for (std::size_t j{}; j < 6; j++) {
+            double uu{};
+            double vv{};
+            for (std::size_t k{}; k < rows; k++) {
+                uu += svd.u().get(k, i) * svd.u().get(k, j);
+            }
+            for (std::size_t k{}; k < columns; k++) {
+                vv += svd.v().get(k, i) * svd.v().get(k, j);
+            }
+            EXPECT_NEAR(uu, i == j ? 1. : 0., 1e-10);
+            EXPECT_NEAR(vv, i == j ? 1. : 0., 1e-10);
+        }
+    }
+}
+
+TEST(matrix_svd_test, small_singular_values)
+{
+    constexpr std::size_t rows    = 120;
+    constexpr std::size_t columns = 80;
+    constexpr std::size_t inner   = 12;
+    using left_type               = matrix<double, rows, inner, 8>;
+    using right_type              = matrix<double, columns, inner, 8>;
+    using a_type                  = matrix<double, rows, columns, 8>;
+
+    // sigma_i = 10^-i goes far below sqrt(eps) * sigma_max, where squaring B * B^T would lose it
+    auto mX = std::make_unique<left_type>(left_type::get_rand_matrix(34));
+    auto mY = std::make_unique<right_type>(right_type::get_rand_matrix(35));
+    qr<double, rows, inner, 8>{*mX}.q(*mX);
+    qr<double, columns, inner, 8>{*mY}.q(*mY);
+    mX->for_each([](std::size_t, std::size_t column, double& item) { item *= std::pow(10., -static_cast<int>(column)); });
+    auto mYt = std::make_unique<matrix<double, inner, columns, 8>>();
+    auto mA  = std::make_unique<a_type>();
+    mY->transpose(*mYt);
+    mX->mult(*mYt, *mA);
+
+    truncated_svd<double, rows, columns, 10, 8> const svd{*mA};
+    for (std::size_t i{}; i < 10; i++) {
+        EXPECT_NEAR(svd.values()[i] / std::pow(10., -static_cast<int>(i)), 1., 1e-5) << "sigma " << i;
+    }
+}
+
+TEST(matrix_svd_test, svd_1024_time)
+{
+    using a_type = matrix<double, 1024, 512, 32>;
+    auto mA      = std::make_unique<a_type>(a_type::get_rand_matrix(33));
+
+    auto start = std::chrono::high_resolution_clock::now();
+    auto svd   = std::make_unique<truncated_svd<double, 1024, 512, 8, 32>>(*mA, 1);
+    auto stop  = std::chrono::high_resolution_clock::now();
+    std::cout << "Truncated SVD 1024x512 rank 8: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() << " us" << std::endl;
+    // The mean of the uniform entries gives one dominant singular value of about sqrt(1024 * 512) / 2
+    EXPECT_NEAR(svd->values()[0], std::sqrt(1024. * 512.) / 2., 5.);
+}
@@ -63,3 +63,57 @@ TEST(matrix_test, matrix_strassen_4x4)
         }
     }
 }
+
+TEST(matrix_test, matrix_strassen_8x8)
+{
+    std::array<int, 64> A{};
+    std::array<int, 64> B{};
+    for (std::size_t i{}; i < 64; i++) {
+        A[i] = static_cast<int>(i % 7) - 3;
+        B[i] = static_cast<int>(i % 5) - 2;
+    }
+
+    matrix_strassen<int, 8> mA{A};
+    matrix_strassen<int, 8> mB{B};
+
+    auto mC = mA * mB;
+
+    for (std::size_t l{}; l < 8; l++) {
+        for (std::size_t m{}; m < 8; m++) {
+            int expected{};
+            for (std::size_t k{}; k < 8; k++) {
+                expected += A[l * 8 + k] * B[k * 8 + m];
+            }
+            EXPECT_EQ(expected, mC.get(l, m));
+        }
+    }
+}
+
+TEST(matrix_test, matrix_strassen_morton_layout)
+{
+    for (std::size_t row{}; row < 64; row++) {
+        for (std::size_t column{}; column < 64; column++) {
+            auto const index = morton_index(row, column);
+            EXPECT_EQ(std::make_pair(row, column), morton_position(index));
+        }
+    }
+    EXPECT_EQ(morton_index(0, 1), 1);
+    EXPECT_EQ(morton_index(1, 0), 2);
+    EXPECT_EQ(morton_index(0, 2), 4);
+    EXPECT_EQ(morton_index(2, 0), 8);
+
+    std::array<int, 64> A{};
+    for (std::size_t i{}; i < A.size(); i++) {
+        A[i] = static_cast<int>(i);
+    }
+    matrix_strassen<int, 8> const mA{A};
+
+    std::size_t index{};
+    for (auto const& item : mA) {
+        auto const [row, column] = morton_position(index++);
+        EXPECT_EQ(A[row * 8 + column], item);
+        EXPECT_EQ(&item, &mA.get(row, column));
+    }
+    EXPECT_EQ(index, mA.size());
+    EXPECT_EQ(A, mA.row_major());
+}
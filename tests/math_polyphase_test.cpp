@@ -0,0 +1,214 @@
+#include <xitren/math/polyphase.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+using namespace xitren::math;
+
+static std::vector<double>
+signal(std::size_t size)
+{
+    std::vector<double> ret(size);
+    for (std::size_t i{}; i < size; i++) {
+        ret[i] = std::sin(0.05 * static_cast<double>(i)) + 0.3 * std::sin(0.9 * static_cast<double>(i * i % 37));
+    }
+    return ret;
+}
+
+template <std::size_t Order, std::size_t M>
+static void
+check_decimator(std::size_t size, std::size_t step)
+{
+    auto const          in = signal(size);
+    filter<Order + 1>   reference{lowpass<Order, 1, 2 * M>::prepare_table()};
+    decimator<Order, M> fast;
+    std::vector<double> expected;
+    std::vector<double> out(size / M + 1);
+    std::size_t         written{};
+    for (std::size_t i{}; i < size; i++) {
+        auto const value = reference.value(in[i]);
+        if ((i + 1) % M == 0) {
+            expected.push_back(value);
+        }
+    }
+    for (std::size_t done{}; done < size; done += step) {
+        auto const count    = std::min(step, size - done);
+        auto const capacity = fast.capacity(count);
+        auto const produced = fast.process(std::span{in}.subspan(done, count), std::span{out}.subspan(written));
+        EXPECT_EQ(capacity, produced);
+        written += produced;
+    }
+    ASSERT_EQ(expected.size(), written);
+    for (std::size_t i{}; i < written; i++) {
+        EXPECT_NEAR(expected[i], out[i], 1e-12) << i;
+    }
+}
+
+template <std::size_t Order, std::size_t L>
+static void
+check_interpolator(std::size_t size, std::size_t step)
+{
+    auto const             in = signal(size);
+    filter<Order + 1>      reference{lowpass<Order, 1, 2 * L>::prepare_table()};
+    interpolator<Order, L> fast;
+    std::vector<double>    out(size * L);
+    std::size_t            written{};
+    for (std::size_t done{}; done < size; done += step) {
+        auto const count    = std::min(step, size - done);
+        auto const capacity = fast.capacity(count);
+        auto const produced = fast.process(std::span{in}.subspan(done, count), std::span{out}.subspan(written));
+        EXPECT_EQ(capacity, produced);
+        written += produced;
+    }
+    ASSERT_EQ(size * L, written);
+    for (std::size_t i{}; i < size * L; i++) {
+        auto const expected = static_cast<double>(L) * reference.value((i % L == 0) ? in[i / L] : 0.);
+        EXPECT_NEAR(expected, out[i], 1e-12) << i;
+    }
+}
+
+template <std::size_t L, std::size_t M, std::size_t Order>
+static void
+check_resampler(std::size_t size, std::size_t step)
+{
+    auto const             in = signal(size);
+    filter<Order + 1>      reference{lowpass<Order, 1, 2 * std::max(L, M)>::prepare_table()};
+    resampler<L, M, Order> fast;
+    std::vector<double>    expected;
+    std::vector<double>    out(size * L / M + 2);
+    std::size_t            written{};
+    for (std::size_t i{}; i < size * L; i++) {
+        auto const value = static_cast<double>(L) * reference.value((i % L == 0) ? in[i / L] : 0.);
+        if (i % M == 0) {
+            expected.push_back(value);
+        }
+    }
+    for (std::size_t done{}; done < size; done += step) {
+        auto const count    = std::min(step, size - done);
+        auto const capacity = fast.capacity(count);
+        auto const produced = fast.process(std::span{in}.subspan(done, count), std::span{out}.subspan(written));
+        EXPECT_EQ(capacity, produced);
+        written += produced;
+    }
+    ASSERT_EQ(expected.size(), written);
+    for (std::size_t i{}; i < written; i++) {
+        EXPECT_NEAR(expected[i], out[i], 1e-12) << i;
+    }
+}
+
+TEST(polyphase_test, decimator_matches_lowpass)
+{
+    check_decimator<63, 8>(5000, 5000);
+    check_decimator<63, 8>(5000, 333);
+    check_decimator<20, 3>(1000, 7);
+    check_decimator<4, 16>(1000, 100);
+    check_decimator<10, 1>(300, 64);
+}
+
+TEST(polyphase_test, interpolator_matches_lowpass)
+{
+    check_interpolator<63, 8>(1000, 1000);
+    check_interpolator<63, 8>(1000, 77);
+    check_interpolator<20, 3>(500, 5);
+    check_interpolator<4, 16>(300, 100);
+    check_interpolator<10, 1>(300, 64);
+}
+
+TEST(polyphase_test, resampler_matches_lowpass)
+{
+    check_resampler<3, 2, 47>(1000, 1000);
+    check_resampler<3, 2, 47>(1000, 13);
+    check_resampler<2, 3, 47>(1000, 1);
+    check_resampler<5, 5, 20>(500, 64);
+    check_resampler<147, 160, 2560>(3000, 441);
+    check_resampler<160, 147, 2560>(3000, 480);
+}
+
+TEST(polyphase_test, resampler_short_output)
+{
+    auto const            in = signal(100);
+    resampler<3, 2>       fast;
+    std::array<double, 5> out{};
+    EXPECT_THROW(fast.process(in, out), std::length_error);
+    std::vector<double> wide(fast.capacity(in.size()));
+    EXPECT_EQ(fast.process(in, wide), 150U);
+}
+
+TEST(polyphase_test, decimator_short_output)
+{
+    auto const            in = signal(100);
+    decimator<15, 4>      fast;
+    std::array<double, 5> out{};
+    EXPECT_THROW(fast.process(in, out), std::length_error);
+    std::vector<double> wide(fast.capacity(in.size()));
+    EXPECT_EQ(fast.process(in, wide), 25U);
+    EXPECT_EQ(fast.capacity(3), 0U);
+    EXPECT_EQ(fast.capacity(4), 1U);
+}
+
+TEST(polyphase_test, interpolator_short_output)
+{
+    auto const             in = signal(100);
+    interpolator<15, 4>    fast;
+    std::array<double, 37> out{};
+    EXPECT_THROW(fast.process(in, out), std::length_error);
+    std::vector<double> wide(fast.capacity(in.size()));
+    EXPECT_EQ(fast.process(in, wide), 400U);
+    EXPECT_EQ(fast.capacity(3), 12U);
+}
+
+TEST(polyphase_test, decimator_time)
+{
+    constexpr std::size_t size = 1 << 16;
+    auto const            in   = signal(size);
+    std::vector<double>   out(size);
+    decimator<255, 16>    fast;
+    filter<256>           slow{lowpass<255, 1, 32>::prepare_table()};
+
+    auto start = std::chrono::high_resolution_clock::now();
+    fast.process(in, out);
+    auto stop = std::chrono::high_resolution_clock::now();
+    std::cout << "decimator 256 taps by 16: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() << " us" << std::endl;
+    start = std::chrono::high_resolution_clock::now();
+    slow.process(in, out);
+    stop = std::chrono::high_resolution_clock::now();
+    std::cout << "lowpass then discard: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() << " us" << std::endl;
+}
+
+TEST(polyphase_test, resampler_time)
+{
+    constexpr std::size_t size = 4800;
+    auto const            in   = signal(size);
+    std::vector<double>   out(size);
+    resampler<147, 160>   fast;
+    filter<2561>          slow{lowpass<2560, 1, 320>::prepare_table()};
+    std::vector<double>   stuffed(size * 147);
+    std::vector<double>   filtered(size * 147);
+    for (std::size_t i{}; i < size; i++) {
+        stuffed[i * 147] = in[i];
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    fast.process(in, out);
+    auto stop = std::chrono::high_resolution_clock::now();
+    std::cout << "resampler 48 kHz to 44.1 kHz, 0.1 s: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() << " us" << std::endl;
+    start = std::chrono::high_resolution_clock::now();
+    slow.process(stuffed, filtered);
+    for (std::size_t i{}; i < out.size(); i++) {
+        out[i] = 147. * filtered[i * 160 % filtered.size()];
+    }
+    stop = std::chrono::high_resolution_clock::now();
+    std::cout << "zero-stuff, lowpass, discard: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() << " us" << std::endl;
+}
@@ -0,0 +1,83 @@
+#include <xitren/math/matrix.hpp>
+#include <xitren/math/matrix_classic.hpp>
+#include <xitren/math/matrix_strassen.hpp>
+#include <xitren/math/random.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace xitren::math;
+
+TEST(random_test, reproducible_stream)
+{
+    EXPECT_EQ(counter_random::bits(42, 7), counter_random::bits(42, 7));
+    EXPECT_NE(counter_random::bits(42, 7), counter_random::bits(43, 7));
+    EXPECT_NE(counter_random::bits(42, 7), counter_random::bits(42, 8));
+    EXPECT_NE(counter_random::seed(), counter_random::seed());
+
+    double sum{};
+    for (std::size_t i{}; i < 100000; i++) {
+        auto const val = counter_random::value<double>(1, i);
+        EXPECT_GE(val, 0.);
+        EXPECT_LT(val, 1.);
+        sum += val;
+    }
+    EXPECT_NEAR(sum / 100000, 0.5, 0.01);
+
+    for (std::size_t i{}; i < 1000; i++) {
+        auto const val = counter_random::value<int>(1, i);
+        EXPECT_GE(val, 0);
+        EXPECT_LE(val, RAND_MAX);
+    }
+}
+
+TEST(random_test, parallel_fill_matches_serial)
+{
+    std::vector<float> data(1 << 20);
+    counter_random::fill(data.data(), data.size(), 5, 100);
+    for (std::size_t i{}; i < data.size(); i++) {
+        ASSERT_EQ(counter_random::value<float>(5, 100 + i), data[i]);
+    }
+}
+
+TEST(random_test, matrices_share_logical_layout)
+{
+    constexpr std::uint64_t seed = 1234;
+
+    static auto const mS = matrix_strassen<int, 64>::get_rand_matrix(seed);
+    static auto const mC = matrix_classic<int, 64, 64>::get_rand_matrix(seed);
+    static auto const mA = matrix<int, 64, 64, 16>::get_rand_matrix(seed);
+    static auto const mB = matrix<int, 64, 64, 8>::get_rand_matrix(seed);
+    static auto const mU = matrix<int, 77, 30, 16>::get_rand_matrix(seed);
+    for (std::size_t i{}; i < 64; i++) {
+        for (std::size_t j{}; j < 64; j++) {
+            EXPECT_EQ(mS.get(i, j), mC[i][j]);
+            EXPECT_EQ(mS.get(i, j), mA.get(i, j));
+            EXPECT_EQ(mS.get(i, j), mB.get(i, j));
+        }
+    }
+    for (std::size_t i{}; i < 77; i++) {
+        for (std::size_t j{}; j < 30; j++) {
+            EXPECT_EQ(counter_random::value<int>(seed, i * 30 + j), mU.get(i, j));
+        }
+    }
+
+    auto const m2 = matrix_strassen<double, 2>::get_rand_matrix(seed);
+    EXPECT_EQ(counter_random::value<double>(seed, 3), m2.get(1, 1));
+}
+
+TEST(random_test, big_matrix_time)
+{
+    using loc_type = matrix<double, 1025, 1025>;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    static auto const mA = loc_type::get_rand_matrix(7);
+    auto stop = std::chrono::high_resolution_clock::now();
+    std::cout << "Random 1025x1025: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() << " us" << std::endl;
+    EXPECT_EQ(counter_random::value<double>(7, 1024 * 1025 + 1024), mA.get(1024, 1024));
+}
@@ -0,0 +1,138 @@
+#include <xitren/math/matrix.hpp>
+#include <xitren/math/semiring.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <limits>
+
+using namespace xitren::math;
+
+template <class Semiring, class Type, std::size_t Rows, std::size_t Inner, std::size_t Columns, std::size_t Batch>
+static void
+check_naive(matrix<Type, Rows, Inner, Batch> const& a, matrix<Type, Inner, Columns, Batch> const& b,
+            matrix<Type, Rows, Columns, Batch> const& c)
+{
+    auto const ra = a.row_major();
+    auto const rb = b.row_major();
+    auto const rc = c.row_major();
+    for (std::size_t i{}; i < Rows; i++) {
+        for (std::size_t j{}; j < Columns; j++) {
+            Type sum = Semiring::zero();
+            for (std::size_t k{}; k < Inner; k++) {
+                sum = Semiring::add(sum, Semiring::mul(ra[i * Inner + k], rb[k * Columns + j]));
+            }
+            EXPECT_EQ(sum, rc[i * Columns + j]);
+        }
+    }
+}
+
+TEST(semiring_test, min_plus_uneven)
+{
+    static auto mA = matrix<double, 37, 45, 8>::get_rand_matrix(1);
+    static auto mB = matrix<double, 45, 21, 8>::get_rand_matrix(2);
+    static matrix<double, 37, 21, 8> mC{};
+
+    mA.mult<min_plus<double>>(mB, mC);
+    check_naive<min_plus<double>>(mA, mB, mC);
+}
+
+TEST(semiring_test, min_plus_batch_2)
+{
+    // 2x2 tiles take the matrix_strassen<Type, 2> specialization
+    static auto mA = matrix<double, 7, 6, 2>::get_rand_matrix(9);
+    static auto mB = matrix<double, 6, 5, 2>::get_rand_matrix(10);
+    static matrix<double, 7, 5, 2> mC{};
+
+    mA.mult<min_plus<double>>(mB, mC);
+    check_naive<min_plus<double>>(mA, mB, mC);
+}
+
+TEST(semiring_test, max_plus_and_max_times)
+{
+    static auto mA = matrix<int, 19, 33, 4>::get_rand_matrix(3);
+    static auto mB = matrix<int, 33, 18, 4>::get_rand_matrix(4);
+    mA.for_each([](std::size_t, std::size_t, int& item) { item = static_cast<int>(static_cast<unsigned>(item) % 100); });
+    mB.for_each([](std::size_t, std::size_t, int& item) { item = static_cast<int>(static_cast<unsigned>(item) % 100); });
+    mA.get(0, 0) = max_plus<int>::zero();
+
+    static matrix<int, 19, 18, 4> mC{};
+    mA.mult<max_plus<int>>(mB, mC);
+    check_naive<max_plus<int>>(mA, mB, mC);
+    mA.mult<max_times<int>>(mB, mC);
+    check_naive<max_times<int>>(mA, mB, mC);
+}
+
+TEST(semiring_test, integral_mul_saturates)
+{
+    constexpr auto max    = std::numeric_limits<int>::max();
+    constexpr auto lowest = std::numeric_limits<int>::lowest();
+    EXPECT_EQ(min_plus<int>::zero(), min_plus<int>::mul(max - 1, max - 1));
+    EXPECT_EQ(lowest, min_plus<int>::mul(lowest + 1, -2));
+    EXPECT_EQ(max - 1, min_plus<int>::mul(max / 2, max / 2));
+    EXPECT_EQ(max_plus<int>::zero(), max_plus<int>::mul(lowest + 1, lowest + 1));
+    EXPECT_EQ(max, max_plus<int>::mul(max - 1, 2));
+    EXPECT_EQ(std::numeric_limits<unsigned>::max(), min_plus<unsigned>::mul(4000000000U, 4000000000U));
+    EXPECT_EQ(7U, min_plus<unsigned>::mul(3U, 4U));
+}
+
+TEST(semiring_test, plus_times_is_gemm)
+{
+    static auto mA = matrix<int, 20, 12, 4>::get_rand_matrix(5);
+    static auto mB = matrix<int, 12, 9, 4>::get_rand_matrix(6);
+    mA.for_each([](std::size_t, std::size_t, int& item) { item %= 1000; });
+    mB.for_each([](std::size_t, std::size_t, int& item) { item %= 1000; });
+
+    static matrix<int, 20, 9, 4> mC{};
+    static matrix<int, 20, 9, 4> mD{};
+    mA.mult<plus_times<int>>(mB, mC);
+    mA.mult(mB, mD);
+    EXPECT_EQ(mC.row_major(), mD.row_major());
+    check_naive<plus_times<int>>(mA, mB, mC);
+}
+
+TEST(semiring_test, all_pairs_shortest_paths)
+{
+    // Ring of 70 vertices with unit edges plus a chord 0 -> 35 of weight 3
+    constexpr std::size_t size = 70;
+    constexpr auto        inf  = min_plus<double>::zero();
+    using loc_type             = matrix<double, size, size, 16>;
+
+    static loc_type mD{};
+    mD.for_each([](std::size_t i, std::size_t j, double& item) {
+        item = (i == j) ? 0. : (((i + 1) % size == j) ? 1. : inf);
+    });
+    mD.get(0, 35) = 3.;
+
+    // Repeated squaring of the distance matrix, every step doubles the path length
+    static loc_type mP{};
+    for (std::size_t length{1}; length < size; length <<= 1) {
+        mD.mult<min_plus<double>>(mD, mP);
+        mD = mP;
+    }
+    EXPECT_EQ(mD.get(0, 35), 3.);
+    EXPECT_EQ(mD.get(0, 40), 8.);
+    EXPECT_EQ(mD.get(0, 34), 34.);
+    EXPECT_EQ(mD.get(36, 35), 37.);
+    EXPECT_EQ(mD.get(36, 0), 34.);
+}
+
+TEST(semiring_test, min_plus_512_time)
+{
+    static auto mA = matrix<double, 512, 512, 64>::get_rand_matrix(7);
+    static auto mB = matrix<double, 512, 512, 64>::get_rand_matrix(8);
+    static matrix<double, 512, 512, 64> mC{};
+
+    auto start = std::chrono::high_resolution_clock::now();
+    mA.mult<min_plus<double>>(mB, mC);
+    auto stop = std::chrono::high_resolution_clock::now();
+    std::cout << "Min-plus 512x512: " << std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count()
+              << " us" << std::endl;
+
+    double expected = min_plus<double>::zero();
+    for (std::size_t k{}; k < 512; k++) {
+        expected = std::min(expected, mA.get(100, k) + mB.get(k, 200));
+    }
+    EXPECT_EQ(expected, mC.get(100, 200));
+}
@@ -0,0 +1,89 @@
+#include <xitren/math/autotune.hpp>
+#include <xitren/math/matrix.hpp>
+#include <xitren/math/matrix_strassen.hpp>
+#include <xitren/math/tuning.hpp>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <iostream>
+
+using namespace xitren::math;
+
+TEST(tuning_test, default_batch_value)
+{
+    EXPECT_EQ((matrix<double, 77, 30>::batch_value), 16);
+    EXPECT_EQ((matrix<double, 30, 77>::batch_value), 16);
+    EXPECT_EQ((matrix<double, 3, 4>::batch_value), 2);
+    EXPECT_EQ((matrix<double, 100, 200>::batch_value), 64);
+    EXPECT_EQ((matrix<double, 1025, 1025>::batch_value), 128);
+    EXPECT_EQ((matrix<double, 77, 30, 8>::batch_value), 8);
+}
+
+TEST(tuning_test, save_and_load)
+{
+    auto const path = std::filesystem::temp_directory_path() / "xitren_math_tuning_test.cfg";
+
+    tuning_parameters saved{};
+    saved.batch           = 32;
+    saved.strassen_cutoff = 16;
+    saved.kernel_rows     = 8;
+    saved.threads         = 3;
+    EXPECT_TRUE(tuning::save(path, saved));
+
+    tuning_parameters loaded{};
+    EXPECT_TRUE(tuning::load(path, loaded));
+    EXPECT_EQ(loaded.batch, 32);
+    EXPECT_EQ(loaded.strassen_cutoff, 16);
+    EXPECT_EQ(loaded.kernel_rows, 8);
+    EXPECT_EQ(loaded.threads, 3);
+
+    // Only an explicit load changes the parameters in use
+    auto const initial = tuning::current();
+    EXPECT_EQ(initial.strassen_cutoff, tuning_parameters{}.strassen_cutoff);
+    EXPECT_TRUE(tuning::load(path));
+    EXPECT_EQ(tuning::current().strassen_cutoff, 16);
+    EXPECT_EQ(tuning::current().kernel_rows, 8);
+    tuning::set(initial);
+    std::filesystem::remove(path);
+
+    EXPECT_FALSE(tuning::load(path, loaded));
+    EXPECT_FALSE(tuning::load(path));
+    EXPECT_EQ(tuning::current().strassen_cutoff, initial.strassen_cutoff);
+}
+
+TEST(tuning_test, cutoff_keeps_product)
+{
+    auto const initial = tuning::current();
+    auto const mA      = matrix_strassen<int, 64>::get_rand_matrix(1);
+    auto const mB      = matrix_strassen<int, 64>::get_rand_matrix(2);
+
+    auto params            = initial;
+    params.strassen_cutoff = 2;
+    tuning::set(params);
+    auto const strassen = (mA * mB).row_major();
+    for (std::size_t rows : {1, 2, 4, 8}) {
+        params.strassen_cutoff = 64;
+        params.kernel_rows     = rows;
+        tuning::set(params);
+        EXPECT_EQ(strassen, (mA * mB).row_major());
+        params.strassen_cutoff = 16;
+        tuning::set(params);
+        EXPECT_EQ(strassen, (mA * mB).row_major());
+    }
+    tuning::set(initial);
+}
+
+TEST(tuning_test, autotune)
+{
+    auto const initial = tuning::current();
+    auto const params  = autotune<double, 64>::run(1);
+    std::cout << "batch " << params.batch << " strassen_cutoff " << params.strassen_cutoff << " kernel_rows "
+              << params.kernel_rows << std::endl;
+    EXPECT_GE(params.batch, 16);
+    EXPECT_LE(params.batch, 64);
+    EXPECT_GE(params.strassen_cutoff, 2);
+    EXPECT_LE(params.strassen_cutoff, 64);
+    EXPECT_EQ(params.strassen_cutoff, tuning::current().strassen_cutoff);
+    tuning::set(initial);
+}